@@ -0,0 +1,34 @@
+#ifndef __ANN_NETWORK_H__
+#define __ANN_NETWORK_H__
+
+#include "ann/types_fwd.h"
+#include <vector>
+
+namespace ANN {
+
+    class INetwork
+    {
+    public:
+        virtual std::vector< double >
+        Compute( const std::vector< double > & inputs ) const = 0;
+
+        // Outputs of rowCount rows of inputs, both stored row after row;
+        // the outputs grow to fit if needed. Runs Compute() row by row
+        // unless the network has a better way.
+        virtual void
+        ComputeBatch( const std::vector< double > & inputs, unsigned rowCount,
+                      std::vector< double > & outputs ) const;
+
+        virtual unsigned
+        GetInputsCount() const = 0;
+
+        virtual unsigned
+        GetOutputsCount() const = 0;
+
+        virtual
+        ~INetwork() {}
+    };
+
+} // namespace ANN
+
+#endif // __ANN_NETWORK_H__
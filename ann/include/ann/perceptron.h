@@ -0,0 +1,66 @@
+#ifndef __ANN_PERCEPTRON_H__
+#define __ANN_PERCEPTRON_H__
+
+#include "ann/network.h"
+#include "boost/serialization/access.hpp"
+#include "boost/serialization/vector.hpp"
+#include <vector>
+
+namespace ANN {
+
+    // Single layer of tanh units. The weights of an output are its input
+    // weights followed by its bias, and the outputs follow each other, so
+    // the weights are outputs * ( inputs + 1 ) values; that is also the
+    // genome of the genetic algorithm.
+
+    class Perceptron : public INetwork
+    {
+    public:
+        std::vector< double >
+        Compute( const std::vector< double > & inputs ) const;
+
+        // Runs the rows in blocks, so every weight row is loaded once per
+        // block instead of once per row
+        void
+        ComputeBatch( const std::vector< double > & inputs, unsigned rowCount,
+                      std::vector< double > & outputs ) const;
+
+        unsigned
+        GetInputsCount() const { return mInputsCount; }
+
+        unsigned
+        GetOutputsCount() const { return mOutputsCount; }
+
+        const std::vector< double > &
+        GetWeights() const { return mWeights; }
+
+        static unsigned
+        GetWeightsCount( unsigned inputsCount, unsigned outputsCount )
+            { return outputsCount * ( inputsCount + 1 ); }
+
+    public:
+        Perceptron( unsigned inputsCount, unsigned outputsCount, const double * weights );
+
+        // Empty, to be loaded from an archive
+        Perceptron();
+        ~Perceptron();
+
+    private:
+        friend class boost::serialization::access;
+
+        template < class Archive >
+        void
+        serialize( Archive & archive, const unsigned /* version */ )
+        {
+            archive & mInputsCount & mOutputsCount & mWeights;
+        }
+
+    private:
+        unsigned                mInputsCount;
+        unsigned                mOutputsCount;
+        std::vector< double >   mWeights;
+    };
+
+} // namespace ANN
+
+#endif // __ANN_PERCEPTRON_H__
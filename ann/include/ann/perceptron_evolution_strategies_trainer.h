@@ -0,0 +1,50 @@
+#ifndef __ANN_PERCEPTRON_EVOLUTION_STRATEGIES_TRAINER_H__
+#define __ANN_PERCEPTRON_EVOLUTION_STRATEGIES_TRAINER_H__
+
+#include "ann/perceptron_trainer.h"
+#include "ann/types_fwd.h"
+#include <cstdint>
+
+namespace Cmn {
+    class ThreadPool;
+}
+
+namespace ANN {
+
+    // Natural evolution strategies: a generation is pairs of mirrored
+    // samples around a mean, mean + deviation * noise and mean - deviation
+    // * noise, and the mean follows the gradient of the ranked fitness
+    // estimated from them, with Adam.
+    //
+    // The noise of a sample is a slice of a table of normal values made
+    // once from the seed, so a sample is fully described by the offset
+    // of its slice: evaluating it elsewhere only takes the offset, and
+    // only its fitness has to come back. The saved state is the mean, the
+    // moments of Adam, the seed and the generation counter.
+
+    class IPerceptronEvolutionStrategiesTrainer : public IPerceptronTrainer
+    {
+    public:
+        // The current mean, the network the search converges to
+        virtual ConstPerceptronRef
+        GetMean() = 0;
+
+        // Step size of the mean
+        virtual void
+        SetLearningRate( float ) = 0;
+
+        // Standard deviation of the samples around the mean
+        virtual void
+        SetNoiseDeviation( float ) = 0;
+    };
+
+    // The population is twice pairCount samples. The mean starts random,
+    // uniform in [-1, 1], and is updated on the pool.
+    IPerceptronEvolutionStrategiesTrainerRef
+    CreatePerceptronEvolutionStrategiesTrainer(
+        FitnessOp, unsigned inputsCount, unsigned outputsCount, unsigned pairCount,
+        Cmn::ThreadPool &, uint64_t seed = 0 );
+
+} // namespace ANN
+
+#endif // __ANN_PERCEPTRON_EVOLUTION_STRATEGIES_TRAINER_H__
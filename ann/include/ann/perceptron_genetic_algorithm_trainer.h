@@ -0,0 +1,43 @@
+#ifndef __ANN_PERCEPTRON_GENETIC_ALGORITHM_TRAINER_H__
+#define __ANN_PERCEPTRON_GENETIC_ALGORITHM_TRAINER_H__
+
+#include "ann/perceptron_trainer.h"
+#include "ann/types_fwd.h"
+#include <cstdint>
+
+namespace Cmn {
+    class ThreadPool;
+}
+
+namespace ANN {
+
+    // Elitist genetic algorithm: tournament selection, uniform crossover
+    // and gaussian mutation. Its saved state is the population, the
+    // fitness of the last generation, the seed and the generation counter.
+
+    class IPerceptronGeneticAlgorithmTrainer : public IPerceptronTrainer
+    {
+    public:
+        // Chance of every weight of a child to be mutated
+        virtual void
+        SetMutationProbability( float ) = 0;
+
+        // Standard deviation of the noise added to a mutated weight
+        virtual void
+        SetMutationSpeed( float ) = 0;
+
+        // Individuals carried over to the next generation unchanged
+        virtual unsigned
+        GetEliteCount() const = 0;
+    };
+
+    // The population is random, uniform in [-1, 1], and is bred on the
+    // pool the same way for the same seed whatever the number of threads
+    IPerceptronGeneticAlgorithmTrainerRef
+    CreatePerceptronGeneticAlgorithmTrainer(
+        FitnessOp, unsigned inputsCount, unsigned outputsCount, unsigned populationSize,
+        Cmn::ThreadPool &, uint64_t seed = 0 );
+
+} // namespace ANN
+
+#endif // __ANN_PERCEPTRON_GENETIC_ALGORITHM_TRAINER_H__
@@ -0,0 +1,56 @@
+#ifndef __ANN_PERCEPTRON_TRAINER_H__
+#define __ANN_PERCEPTRON_TRAINER_H__
+
+#include "ann/perceptron.h"
+#include "ann/types_fwd.h"
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace ANN {
+
+    // Lower is fitter
+    typedef std::function< double( ConstPerceptronIn ) > FitnessOp;
+
+    // Fitness of a whole generation at once, for evaluations that share
+    // work or effort across individuals
+    typedef std::function< void( const std::vector< ConstPerceptronRef > &,
+                                 std::vector< double > & fitness ) > GenerationFitnessOp;
+
+    // Search for the perceptron weights minimising a fitness op
+
+    class IPerceptronTrainer
+    {
+    public:
+        // Evaluates a generation, moves the search on and returns the
+        // fitness of the fittest individual evaluated
+        virtual double
+        Step() = 0;
+
+        // The fittest individual of the last Step()
+        virtual ConstPerceptronRef
+        GetFittest() = 0;
+
+        // Evaluates the generations with this op from now on, instead of
+        // calling the fitness op for each individual
+        virtual void
+        SetGenerationFitnessOp( GenerationFitnessOp ) = 0;
+
+        // State of the search, enough for a trainer of the same shape to go
+        // on with the same search
+        virtual void
+        Save( std::ostream & ) const = 0;
+
+        // Restores a saved search; false, with nothing changed, if the
+        // stream is malformed or comes from another shape of trainer
+        virtual bool
+        Load( std::istream & ) = 0;
+
+    public:
+        virtual ~IPerceptronTrainer() {}
+    };
+
+} // namespace ANN
+
+#endif // __ANN_PERCEPTRON_TRAINER_H__
@@ -0,0 +1,20 @@
+#ifndef __ANN_SEED_H__
+#define __ANN_SEED_H__
+
+#include <cstdint>
+
+namespace ANN {
+
+    // SplitMix64 finaliser: nearby seeds give unrelated random streams
+    inline uint64_t
+    MixSeed( uint64_t value )
+    {
+        value += 0x9E3779B97F4A7C15ull;
+        value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+        value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBull;
+        return value ^ ( value >> 31 );
+    }
+
+} // namespace ANN
+
+#endif // __ANN_SEED_H__
@@ -0,0 +1,17 @@
+#ifndef __ANN_TYPES_FWD_H__
+#define __ANN_TYPES_FWD_H__
+
+#include "cmn/shared_ptr_typedefs.h"
+#include <memory>
+
+namespace ANN {
+
+    SHARED_PTR_FORWARD_TYPEDEFS( INetwork );
+    SHARED_PTR_FORWARD_TYPEDEFS( Perceptron );
+    SHARED_PTR_FORWARD_TYPEDEFS( IPerceptronTrainer );
+    SHARED_PTR_FORWARD_TYPEDEFS( IPerceptronGeneticAlgorithmTrainer );
+    SHARED_PTR_FORWARD_TYPEDEFS( IPerceptronEvolutionStrategiesTrainer );
+
+} // namespace ANN
+
+#endif // __ANN_TYPES_FWD_H__
@@ -0,0 +1,29 @@
+#include "ann/network.h"
+#include "cmn/trace.h"
+
+#include <algorithm>
+
+namespace ANN {
+
+    void INetwork::ComputeBatch( const std::vector< double > & inputs, unsigned rowCount,
+                                 std::vector< double > & outputs ) const
+    {
+        unsigned inputCount     = GetInputsCount();
+        unsigned outputCount    = GetOutputsCount();
+        CMN_ASSERT( inputs.size() >= rowCount * inputCount );
+
+        if ( outputs.size() < rowCount * outputCount )
+        {
+            outputs.resize( rowCount * outputCount );
+        }
+
+        std::vector< double > row( inputCount );
+        for ( unsigned i = 0; i < rowCount; ++ i )
+        {
+            std::copy( inputs.begin() + i * inputCount, inputs.begin() + ( i + 1 ) * inputCount, row.begin() );
+            const std::vector< double > rowOutputs = Compute( row );
+            std::copy( rowOutputs.begin(), rowOutputs.end(), outputs.begin() + i * outputCount );
+        }
+    }
+
+} // namespace ANN
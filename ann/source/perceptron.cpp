@@ -0,0 +1,89 @@
+#include "ann/perceptron.h"
+#include "cmn/trace.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ANN {
+
+    // Rows of a batch computed together
+    static const unsigned kBlockSize = 8;
+
+    Perceptron::Perceptron( unsigned inputsCount, unsigned outputsCount, const double * weights )
+        : mInputsCount( inputsCount )
+        , mOutputsCount( outputsCount )
+        , mWeights( weights, weights + GetWeightsCount( inputsCount, outputsCount ) )
+    {
+    }
+
+    Perceptron::Perceptron()
+        : mInputsCount( 0 )
+        , mOutputsCount( 0 )
+    {
+    }
+
+    Perceptron::~Perceptron()
+    {
+    }
+
+    std::vector< double > Perceptron::Compute( const std::vector< double > & inputs ) const
+    {
+        CMN_ASSERT( inputs.size() == mInputsCount );
+
+        std::vector< double > outputs( mOutputsCount );
+        const double * weights = mWeights.data();
+        for ( unsigned output = 0; output < mOutputsCount; ++ output )
+        {
+            double sum = weights[ mInputsCount ];
+            for ( unsigned input = 0; input < mInputsCount; ++ input )
+            {
+                sum += weights[ input ] * inputs[ input ];
+            }
+            outputs[ output ] = std::tanh( sum );
+            weights += mInputsCount + 1;
+        }
+
+        return outputs;
+    }
+
+    void Perceptron::ComputeBatch( const std::vector< double > & inputs, unsigned rowCount,
+                                   std::vector< double > & outputs ) const
+    {
+        CMN_ASSERT( inputs.size() >= rowCount * mInputsCount );
+
+        if ( outputs.size() < rowCount * mOutputsCount )
+        {
+            outputs.resize( rowCount * mOutputsCount );
+        }
+
+        for ( unsigned first = 0; first < rowCount; first += kBlockSize )
+        {
+            unsigned blockSize = std::min( kBlockSize, rowCount - first );
+            const double * blockInputs = inputs.data() + first * mInputsCount;
+
+            const double * weights = mWeights.data();
+            for ( unsigned output = 0; output < mOutputsCount; ++ output )
+            {
+                double sums[ kBlockSize ];
+                for ( unsigned row = 0; row < blockSize; ++ row )
+                {
+                    const double * rowInputs = blockInputs + row * mInputsCount;
+                    double sum = weights[ mInputsCount ];
+                    for ( unsigned input = 0; input < mInputsCount; ++ input )
+                    {
+                        sum += weights[ input ] * rowInputs[ input ];
+                    }
+                    sums[ row ] = sum;
+                }
+
+                for ( unsigned row = 0; row < blockSize; ++ row )
+                {
+                    outputs[ ( first + row ) * mOutputsCount + output ] = std::tanh( sums[ row ] );
+                }
+
+                weights += mInputsCount + 1;
+            }
+        }
+    }
+
+} // namespace ANN
@@ -0,0 +1,352 @@
+#include "ann/perceptron_evolution_strategies_trainer.h"
+#include "ann/seed.h"
+#include "cmn/thread_pool.h"
+#include "cmn/trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace ANN {
+
+    // Normal values of the noise table; samples are slices of it at random
+    // offsets, so it must be much larger than a genome
+    static const size_t kNoiseTableSize = size_t( 1 ) << 22;
+
+    // Weights of the mean updated by one task
+    static const unsigned kRangeSize = 1024;
+
+    // Adam
+    static const double kBeta1      = 0.9;
+    static const double kBeta2      = 0.999;
+    static const double kEpsilon    = 1e-8;
+
+    class PerceptronEvolutionStrategiesTrainer : public IPerceptronEvolutionStrategiesTrainer
+    {
+    public:
+        double
+        Step();
+
+        ConstPerceptronRef
+        GetFittest();
+
+        ConstPerceptronRef
+        GetMean();
+
+        void
+        SetGenerationFitnessOp( GenerationFitnessOp op ) { mGenerationFitnessOp = op; }
+
+        void
+        SetLearningRate( float learningRate ) { mLearningRate = learningRate; }
+
+        void
+        SetNoiseDeviation( float deviation ) { mNoiseDeviation = deviation; }
+
+        void
+        Save( std::ostream & ) const;
+
+        bool
+        Load( std::istream & );
+
+    public:
+        PerceptronEvolutionStrategiesTrainer(
+            FitnessOp, unsigned inputsCount, unsigned outputsCount, unsigned pairCount,
+            Cmn::ThreadPool &, uint64_t seed );
+
+    private:
+        // Random mean and noise table of a seed
+        void
+        Generate( uint64_t seed, std::vector< double > & mean );
+
+        const float *
+        GetNoise( unsigned pair ) const { return mNoise.data() + mOffsets[ pair ]; }
+
+        // Mean plus or minus deviation times the noise of the pair
+        ConstPerceptronRef
+        MakeSample( unsigned pair, double sign );
+
+        // Gradient and Adam step of the weights [ first, first + count )
+        void
+        Update( unsigned first, unsigned count );
+
+    private:
+        FitnessOp                           mFitnessOp;
+        GenerationFitnessOp                 mGenerationFitnessOp;
+        unsigned                            mInputsCount;
+        unsigned                            mOutputsCount;
+        unsigned                            mPairCount;
+        unsigned                            mGenomeSize;
+        uint64_t                            mSeed;
+        uint64_t                            mGeneration;
+
+        float                               mLearningRate;
+        float                               mNoiseDeviation;
+
+        std::vector< float >                mNoise;
+        std::vector< double >               mMean;
+        std::vector< double >               mMoment1;
+        std::vector< double >               mMoment2;
+
+        // Of the generation being evaluated
+        std::vector< size_t >               mOffsets;
+        std::vector< double >               mFitness;       // positive sample, negative sample, ...
+        std::vector< double >               mUtility;       // of the pair, positive minus negative
+        std::vector< double >               mSample;
+
+        ConstPerceptronRef                  mFittest;
+        Cmn::ThreadPool &                   mThreadPool;
+    };
+
+    PerceptronEvolutionStrategiesTrainer::PerceptronEvolutionStrategiesTrainer(
+        FitnessOp fitnessOp, unsigned inputsCount, unsigned outputsCount, unsigned pairCount,
+        Cmn::ThreadPool & threadPool, uint64_t seed )
+        : mFitnessOp( fitnessOp )
+        , mInputsCount( inputsCount )
+        , mOutputsCount( outputsCount )
+        , mPairCount( pairCount )
+        , mGenomeSize( Perceptron::GetWeightsCount( inputsCount, outputsCount ) )
+        , mSeed( seed )
+        , mGeneration( 0 )
+        , mLearningRate( 0.01f )
+        , mNoiseDeviation( 0.02f )
+        , mNoise( std::max( kNoiseTableSize, size_t( mGenomeSize ) * 16 ) )
+        , mMean( mGenomeSize )
+        , mMoment1( mGenomeSize, 0.0 )
+        , mMoment2( mGenomeSize, 0.0 )
+        , mOffsets( pairCount )
+        , mFitness( pairCount * 2 )
+        , mUtility( pairCount )
+        , mSample( mGenomeSize )
+        , mThreadPool( threadPool )
+    {
+        CMN_ASSERT( pairCount > 0 );
+
+        Generate( seed, mMean );
+    }
+
+    void PerceptronEvolutionStrategiesTrainer::Generate( uint64_t seed, std::vector< double > & mean )
+    {
+        std::mt19937_64 random( MixSeed( seed ) );
+
+        std::uniform_real_distribution< double > uniform( -1.0, 1.0 );
+        for ( double & weight : mean )
+        {
+            weight = uniform( random );
+        }
+
+        std::normal_distribution< float > normal;
+        for ( float & value : mNoise )
+        {
+            value = normal( random );
+        }
+    }
+
+    double PerceptronEvolutionStrategiesTrainer::Step()
+    {
+        std::mt19937_64 random( MixSeed( mSeed ^ MixSeed( mGeneration + 1 ) ) );
+        std::uniform_int_distribution< size_t > offset( 0, mNoise.size() - mGenomeSize );
+        for ( size_t & pairOffset : mOffsets )
+        {
+            pairOffset = offset( random );
+        }
+
+        if ( mGenerationFitnessOp )
+        {
+            std::vector< ConstPerceptronRef > generation( mPairCount * 2 );
+            for ( unsigned pair = 0; pair < mPairCount; ++ pair )
+            {
+                generation[ pair * 2 ] = MakeSample( pair, 1.0 );
+                generation[ pair * 2 + 1 ] = MakeSample( pair, -1.0 );
+            }
+            mGenerationFitnessOp( generation, mFitness );
+            CMN_ASSERT( mFitness.size() == mPairCount * 2 );
+        }
+        else
+        {
+            for ( unsigned pair = 0; pair < mPairCount; ++ pair )
+            {
+                mFitness[ pair * 2 ] = mFitnessOp( MakeSample( pair, 1.0 ) );
+                mFitness[ pair * 2 + 1 ] = mFitnessOp( MakeSample( pair, -1.0 ) );
+            }
+        }
+
+        unsigned fittest = static_cast< unsigned >(
+            std::min_element( mFitness.begin(), mFitness.end() ) - mFitness.begin() );
+        mFittest = MakeSample( fittest / 2, ( fittest & 1 ) ? -1.0 : 1.0 );
+
+        // Centred ranks: the fittest sample is worth 0.5, the least fit
+        // -0.5, whatever the scale of the fitness
+        unsigned sampleCount = mPairCount * 2;
+        std::vector< unsigned > ranking( sampleCount );
+        std::iota( ranking.begin(), ranking.end(), 0 );
+        std::stable_sort( ranking.begin(), ranking.end(),
+            [ this ] ( unsigned a, unsigned b ) { return mFitness[a] < mFitness[b]; } );
+
+        std::vector< double > utility( sampleCount, 0.0 );
+        if ( sampleCount > 1 )
+        {
+            for ( unsigned rank = 0; rank < sampleCount; ++ rank )
+            {
+                utility[ ranking[ rank ] ] = 0.5 - static_cast< double >( rank ) / ( sampleCount - 1 );
+            }
+        }
+        for ( unsigned pair = 0; pair < mPairCount; ++ pair )
+        {
+            mUtility[ pair ] = utility[ pair * 2 ] - utility[ pair * 2 + 1 ];
+        }
+
+        mGeneration ++;
+
+        unsigned rangeCount = ( mGenomeSize + kRangeSize - 1 ) / kRangeSize;
+        if ( rangeCount > 1 )
+        {
+            Cmn::TaskGroup group( mThreadPool );
+            for ( unsigned range = 0; range < rangeCount; ++ range )
+            {
+                unsigned first = range * kRangeSize;
+                unsigned count = std::min( kRangeSize, mGenomeSize - first );
+                group.Submit( [ this, first, count ] { Update( first, count ); } );
+            }
+            group.Wait();
+        }
+        else
+        {
+            Update( 0, mGenomeSize );
+        }
+
+        return mFitness[ fittest ];
+    }
+
+    ConstPerceptronRef PerceptronEvolutionStrategiesTrainer::MakeSample( unsigned pair, double sign )
+    {
+        const float * noise = GetNoise( pair );
+        double deviation = sign * mNoiseDeviation;
+        for ( unsigned i = 0; i < mGenomeSize; ++ i )
+        {
+            mSample[i] = mMean[i] + deviation * noise[i];
+        }
+
+        return std::make_shared< Perceptron >( mInputsCount, mOutputsCount, mSample.data() );
+    }
+
+    void PerceptronEvolutionStrategiesTrainer::Update( unsigned first, unsigned count )
+    {
+        // Gradient of the expected utility, to be climbed
+        std::vector< double > gradient( count, 0.0 );
+        for ( unsigned pair = 0; pair < mPairCount; ++ pair )
+        {
+            double utility = mUtility[ pair ];
+            if ( utility == 0.0 )
+            {
+                continue;
+            }
+
+            const float * noise = GetNoise( pair ) + first;
+            for ( unsigned i = 0; i < count; ++ i )
+            {
+                gradient[i] += utility * noise[i];
+            }
+        }
+
+        double scale = 1.0 / ( 2.0 * mPairCount * mNoiseDeviation );
+        double correction1 = 1.0 - std::pow( kBeta1, static_cast< double >( mGeneration ) );
+        double correction2 = 1.0 - std::pow( kBeta2, static_cast< double >( mGeneration ) );
+        double stepSize = mLearningRate * std::sqrt( correction2 ) / correction1;
+
+        for ( unsigned i = 0; i < count; ++ i )
+        {
+            unsigned weight = first + i;
+            double g = gradient[i] * scale;
+            mMoment1[ weight ] = kBeta1 * mMoment1[ weight ] + ( 1.0 - kBeta1 ) * g;
+            mMoment2[ weight ] = kBeta2 * mMoment2[ weight ] + ( 1.0 - kBeta2 ) * g * g;
+            mMean[ weight ] += stepSize * mMoment1[ weight ] / ( std::sqrt( mMoment2[ weight ] ) + kEpsilon );
+        }
+    }
+
+    ConstPerceptronRef PerceptronEvolutionStrategiesTrainer::GetFittest()
+    {
+        if ( !mFittest )
+        {
+            return GetMean();
+        }
+        return mFittest;
+    }
+
+    ConstPerceptronRef PerceptronEvolutionStrategiesTrainer::GetMean()
+    {
+        return std::make_shared< Perceptron >( mInputsCount, mOutputsCount, mMean.data() );
+    }
+
+    template < typename T >
+    static void Write( std::ostream & stream, const T * data, size_t count )
+    {
+        stream.write( reinterpret_cast< const char * >( data ), count * sizeof( T ) );
+    }
+
+    template < typename T >
+    static bool Read( std::istream & stream, T * data, size_t count )
+    {
+        return !!stream.read( reinterpret_cast< char * >( data ), count * sizeof( T ) );
+    }
+
+    void PerceptronEvolutionStrategiesTrainer::Save( std::ostream & stream ) const
+    {
+        const uint32_t shape[] = { mPairCount, mGenomeSize };
+        Write( stream, shape, 2 );
+        Write( stream, &mSeed, 1 );
+        Write( stream, &mGeneration, 1 );
+        Write( stream, mMean.data(), mMean.size() );
+        Write( stream, mMoment1.data(), mMoment1.size() );
+        Write( stream, mMoment2.data(), mMoment2.size() );
+    }
+
+    bool PerceptronEvolutionStrategiesTrainer::Load( std::istream & stream )
+    {
+        uint32_t shape[2] = { 0, 0 };
+        if ( !Read( stream, shape, 2 ) || shape[0] != mPairCount || shape[1] != mGenomeSize )
+        {
+            return false;
+        }
+
+        uint64_t seed = 0;
+        uint64_t generation = 0;
+        std::vector< double > mean( mGenomeSize );
+        std::vector< double > moment1( mGenomeSize );
+        std::vector< double > moment2( mGenomeSize );
+        if ( !Read( stream, &seed, 1 ) ||
+             !Read( stream, &generation, 1 ) ||
+             !Read( stream, mean.data(), mean.size() ) ||
+             !Read( stream, moment1.data(), moment1.size() ) ||
+             !Read( stream, moment2.data(), moment2.size() ) )
+        {
+            return false;
+        }
+
+        // The samples are slices of the noise table of the seed
+        if ( seed != mSeed )
+        {
+            std::vector< double > unused( mGenomeSize );
+            Generate( seed, unused );
+            mSeed = seed;
+        }
+
+        mGeneration = generation;
+        mMean.swap( mean );
+        mMoment1.swap( moment1 );
+        mMoment2.swap( moment2 );
+        mFittest.reset();
+        return true;
+    }
+
+    IPerceptronEvolutionStrategiesTrainerRef CreatePerceptronEvolutionStrategiesTrainer(
+        FitnessOp fitnessOp, unsigned inputsCount, unsigned outputsCount, unsigned pairCount,
+        Cmn::ThreadPool & threadPool, uint64_t seed /* = 0 */ )
+    {
+        return std::make_shared< PerceptronEvolutionStrategiesTrainer >(
+            fitnessOp, inputsCount, outputsCount, pairCount, threadPool, seed );
+    }
+
+} // namespace ANN
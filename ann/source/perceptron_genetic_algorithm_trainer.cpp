@@ -0,0 +1,339 @@
+#include "ann/perceptron_genetic_algorithm_trainer.h"
+#include "ann/seed.h"
+#include "cmn/thread_pool.h"
+#include "cmn/trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace ANN {
+
+    // Children bred by one task, from one random stream
+    static const unsigned kChunkSize = 8;
+
+    static const unsigned kTournamentSize = 3;
+
+    // The population is a single matrix of genomes, one row per individual
+    // in the layout of Perceptron weights. The next generation is bred into
+    // a second matrix and the two are swapped, so a step allocates nothing
+    // and every operator walks rows of contiguous weights.
+
+    class PerceptronGeneticAlgorithmTrainer : public IPerceptronGeneticAlgorithmTrainer
+    {
+    public:
+        double
+        Step();
+
+        ConstPerceptronRef
+        GetFittest();
+
+        void
+        SetGenerationFitnessOp( GenerationFitnessOp op ) { mGenerationFitnessOp = op; }
+
+        void
+        SetMutationProbability( float probability ) { mMutationProbability = probability; }
+
+        void
+        SetMutationSpeed( float speed ) { mMutationSpeed = speed; }
+
+        unsigned
+        GetEliteCount() const { return mEliteCount; }
+
+        void
+        Save( std::ostream & ) const;
+
+        bool
+        Load( std::istream & );
+
+    public:
+        PerceptronGeneticAlgorithmTrainer(
+            FitnessOp, unsigned inputsCount, unsigned outputsCount, unsigned populationSize,
+            Cmn::ThreadPool &, uint64_t seed );
+
+    private:
+        const double *
+        GetGenome( unsigned individual ) const
+            { return mPopulation.data() + individual * mGenomeSize; }
+
+        // Rank of the parent picked by a tournament
+        unsigned
+        Select( std::mt19937_64 & );
+
+        void
+        Breed( unsigned firstChild, unsigned childCount, std::mt19937_64 & );
+
+        void
+        Crossover( const double * first, const double * second, double * child, std::mt19937_64 & );
+
+        void
+        Mutate( double * child, std::mt19937_64 & );
+
+    private:
+        FitnessOp                           mFitnessOp;
+        GenerationFitnessOp                 mGenerationFitnessOp;
+        unsigned                            mInputsCount;
+        unsigned                            mOutputsCount;
+        unsigned                            mPopulationSize;
+        unsigned                            mGenomeSize;
+        unsigned                            mEliteCount;
+        uint64_t                            mSeed;
+        uint64_t                            mGeneration;
+
+        float                               mMutationProbability;
+        float                               mMutationSpeed;
+
+        std::vector< double >               mPopulation;
+        std::vector< double >               mNextPopulation;
+        std::vector< double >               mFitness;
+        std::vector< unsigned >             mRanking;
+
+        ConstPerceptronRef                  mFittest;
+        Cmn::ThreadPool &                   mThreadPool;
+    };
+
+    PerceptronGeneticAlgorithmTrainer::PerceptronGeneticAlgorithmTrainer(
+        FitnessOp fitnessOp, unsigned inputsCount, unsigned outputsCount, unsigned populationSize,
+        Cmn::ThreadPool & threadPool, uint64_t seed )
+        : mFitnessOp( fitnessOp )
+        , mInputsCount( inputsCount )
+        , mOutputsCount( outputsCount )
+        , mPopulationSize( populationSize )
+        , mGenomeSize( Perceptron::GetWeightsCount( inputsCount, outputsCount ) )
+        , mEliteCount( std::max( populationSize / 10, 1u ) )
+        , mSeed( seed )
+        , mGeneration( 0 )
+        , mMutationProbability( 0.001f )
+        , mMutationSpeed( 0.1f )
+        , mPopulation( populationSize * mGenomeSize )
+        , mNextPopulation( populationSize * mGenomeSize )
+        , mFitness( populationSize )
+        , mRanking( populationSize )
+        , mThreadPool( threadPool )
+    {
+        CMN_ASSERT( populationSize > 0 );
+
+        std::mt19937_64 random( MixSeed( seed ) );
+        std::uniform_real_distribution< double > distribution( -1.0, 1.0 );
+        for ( double & weight : mPopulation )
+        {
+            weight = distribution( random );
+        }
+    }
+
+    double PerceptronGeneticAlgorithmTrainer::Step()
+    {
+        // Every individual is evaluated, the elites again too: the fitness
+        // op plays games and is noisy
+        if ( mGenerationFitnessOp )
+        {
+            std::vector< ConstPerceptronRef > generation( mPopulationSize );
+            for ( unsigned individual = 0; individual < mPopulationSize; ++ individual )
+            {
+                generation[ individual ] = std::make_shared< Perceptron >(
+                    mInputsCount, mOutputsCount, GetGenome( individual ) );
+            }
+            mGenerationFitnessOp( generation, mFitness );
+            CMN_ASSERT( mFitness.size() == mPopulationSize );
+        }
+        else
+        {
+            for ( unsigned individual = 0; individual < mPopulationSize; ++ individual )
+            {
+                ConstPerceptronRef perceptron = std::make_shared< Perceptron >(
+                    mInputsCount, mOutputsCount, GetGenome( individual ) );
+                mFitness[ individual ] = mFitnessOp( perceptron );
+            }
+        }
+
+        std::iota( mRanking.begin(), mRanking.end(), 0 );
+        std::stable_sort( mRanking.begin(), mRanking.end(),
+            [ this ] ( unsigned a, unsigned b ) { return mFitness[a] < mFitness[b]; } );
+
+        unsigned fittest = mRanking[0];
+        double fitness = mFitness[ fittest ];
+        mFittest = std::make_shared< Perceptron >( mInputsCount, mOutputsCount, GetGenome( fittest ) );
+
+        // Elites go first, fittest first
+        for ( unsigned rank = 0; rank < mEliteCount; ++ rank )
+        {
+            const double * genome = GetGenome( mRanking[ rank ] );
+            std::copy( genome, genome + mGenomeSize, mNextPopulation.data() + rank * mGenomeSize );
+        }
+
+        // Children in chunks with a stream each, seeded from the chunk
+        // rather than from the thread that happens to breed it
+        unsigned childCount = mPopulationSize - mEliteCount;
+        unsigned chunkCount = ( childCount + kChunkSize - 1 ) / kChunkSize;
+        uint64_t generationSeed = MixSeed( mSeed ^ MixSeed( mGeneration + 1 ) );
+
+        auto breedChunk = [ this, childCount, generationSeed ] ( unsigned chunk ) {
+            std::mt19937_64 random( MixSeed( generationSeed + chunk ) );
+            unsigned first = chunk * kChunkSize;
+            Breed( mEliteCount + first, std::min( kChunkSize, childCount - first ), random );
+        };
+
+        if ( chunkCount > 1 )
+        {
+            Cmn::TaskGroup group( mThreadPool );
+            for ( unsigned chunk = 0; chunk < chunkCount; ++ chunk )
+            {
+                group.Submit( [ &breedChunk, chunk ] { breedChunk( chunk ); } );
+            }
+            group.Wait();
+        }
+        else if ( chunkCount == 1 )
+        {
+            breedChunk( 0 );
+        }
+
+        mPopulation.swap( mNextPopulation );
+        mGeneration ++;
+
+        return fitness;
+    }
+
+    ConstPerceptronRef PerceptronGeneticAlgorithmTrainer::GetFittest()
+    {
+        if ( !mFittest )
+        {
+            // Nothing evaluated yet: the first individual is the fittest
+            // elite of a loaded search, and as fit as any other of a new one
+            mFittest = std::make_shared< Perceptron >( mInputsCount, mOutputsCount, GetGenome( 0 ) );
+        }
+        return mFittest;
+    }
+
+    template < typename T >
+    static void Write( std::ostream & stream, const T * data, size_t count )
+    {
+        stream.write( reinterpret_cast< const char * >( data ), count * sizeof( T ) );
+    }
+
+    template < typename T >
+    static bool Read( std::istream & stream, T * data, size_t count )
+    {
+        return !!stream.read( reinterpret_cast< char * >( data ), count * sizeof( T ) );
+    }
+
+    void PerceptronGeneticAlgorithmTrainer::Save( std::ostream & stream ) const
+    {
+        const uint32_t shape[] = { mPopulationSize, mGenomeSize };
+        Write( stream, shape, 2 );
+        Write( stream, &mSeed, 1 );
+        Write( stream, &mGeneration, 1 );
+        Write( stream, mPopulation.data(), mPopulation.size() );
+        Write( stream, mFitness.data(), mFitness.size() );
+    }
+
+    bool PerceptronGeneticAlgorithmTrainer::Load( std::istream & stream )
+    {
+        uint32_t shape[2] = { 0, 0 };
+        if ( !Read( stream, shape, 2 ) || shape[0] != mPopulationSize || shape[1] != mGenomeSize )
+        {
+            return false;
+        }
+
+        uint64_t seed = 0;
+        uint64_t generation = 0;
+        std::vector< double > population( mPopulation.size() );
+        std::vector< double > fitness( mFitness.size() );
+        if ( !Read( stream, &seed, 1 ) ||
+             !Read( stream, &generation, 1 ) ||
+             !Read( stream, population.data(), population.size() ) ||
+             !Read( stream, fitness.data(), fitness.size() ) )
+        {
+            return false;
+        }
+
+        mSeed = seed;
+        mGeneration = generation;
+        mPopulation.swap( population );
+        mFitness.swap( fitness );
+
+        // The elites lead the population in rank order, the fittest first
+        mFittest.reset();
+        return true;
+    }
+
+    unsigned PerceptronGeneticAlgorithmTrainer::Select( std::mt19937_64 & random )
+    {
+        std::uniform_int_distribution< unsigned > distribution( 0, mPopulationSize - 1 );
+
+        unsigned best = distribution( random );
+        for ( unsigned i = 1; i < kTournamentSize; ++ i )
+        {
+            best = std::min( best, distribution( random ) );
+        }
+        return best;
+    }
+
+    void PerceptronGeneticAlgorithmTrainer::Breed( unsigned firstChild, unsigned childCount, std::mt19937_64 & random )
+    {
+        for ( unsigned i = 0; i < childCount; ++ i )
+        {
+            const double * first = GetGenome( mRanking[ Select( random ) ] );
+            const double * second = GetGenome( mRanking[ Select( random ) ] );
+            double * child = mNextPopulation.data() + ( firstChild + i ) * mGenomeSize;
+
+            Crossover( first, second, child, random );
+            Mutate( child, random );
+        }
+    }
+
+    void PerceptronGeneticAlgorithmTrainer::Crossover(
+        const double * first, const double * second, double * child, std::mt19937_64 & random )
+    {
+        // Uniform: one random bit per weight, 64 weights per draw. The
+        // inner loop is a select the compiler turns into blends, and the
+        // child gets the very weights of its parents.
+        for ( unsigned block = 0; block < mGenomeSize; block += 64 )
+        {
+            uint64_t mask = random();
+            unsigned blockSize = std::min( 64u, mGenomeSize - block );
+            for ( unsigned i = 0; i < blockSize; ++ i )
+            {
+                child[ block + i ] = ( ( mask >> i ) & 1 ) ? first[ block + i ] : second[ block + i ];
+            }
+        }
+    }
+
+    void PerceptronGeneticAlgorithmTrainer::Mutate( double * child, std::mt19937_64 & random )
+    {
+        if ( mMutationProbability <= 0.0f )
+        {
+            return;
+        }
+
+        // Jumps from one mutated weight to the next instead of drawing for
+        // every weight: with a probability of 0.001 that is a few draws per
+        // genome rather than thousands
+        std::normal_distribution< double > noise( 0.0, mMutationSpeed );
+        if ( mMutationProbability >= 1.0f )
+        {
+            for ( unsigned i = 0; i < mGenomeSize; ++ i )
+            {
+                child[i] += noise( random );
+            }
+            return;
+        }
+
+        std::geometric_distribution< unsigned > skip( mMutationProbability );
+        for ( uint64_t i = skip( random ); i < mGenomeSize; i += 1 + static_cast< uint64_t >( skip( random ) ) )
+        {
+            child[i] += noise( random );
+        }
+    }
+
+    IPerceptronGeneticAlgorithmTrainerRef CreatePerceptronGeneticAlgorithmTrainer(
+        FitnessOp fitnessOp, unsigned inputsCount, unsigned outputsCount, unsigned populationSize,
+        Cmn::ThreadPool & threadPool, uint64_t seed /* = 0 */ )
+    {
+        return std::make_shared< PerceptronGeneticAlgorithmTrainer >(
+            fitnessOp, inputsCount, outputsCount, populationSize, threadPool, seed );
+    }
+
+} // namespace ANN
@@ -13,6 +13,14 @@
     #define CMN_COMPILER_MSVC	1
 #endif // defined( _MSC_VER )
 
+#if defined( __GNUC__ ) && !defined( CMN_COMPILER_MINGW )
+    #define CMN_COMPILER_GCC	1
+#endif // defined( __GNUC__ ) && !defined( CMN_COMPILER_MINGW )
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+    #define CMN_POSIX	1
+#endif // defined( __unix__ ) || defined( __APPLE__ )
+
 #if defined( NDEBUG )
     #define CMN_NDEBUG 1
 #else
@@ -22,14 +30,14 @@
 // Thread local storage
 #if defined( CMN_COMPILER_MSVC )
     #define CMN_THREAD_LOCAL   __declspec( thread )
-#elif defined( CMN_COMPILER_MINGW )
+#elif defined( CMN_COMPILER_MINGW ) || defined( CMN_COMPILER_GCC )
     #define CMN_THREAD_LOCAL   __thread
 #endif
 
 // Some compilers doesn't support noexcept() operator
 #if defined( CMN_COMPILER_MSVC )
     #define CMN_NOEXCEPT( val )
-#elif defined( CMN_COMPILER_MINGW )
+#elif defined( CMN_COMPILER_MINGW ) || defined( CMN_COMPILER_GCC )
     #define CMN_NOEXCEPT( val ) noexcept( val )
 #endif
 
@@ -42,7 +50,7 @@
 // Overriding pragma
 #if defined( CMN_COMPILER_MSVC )
     #define CMN_PRAGMA( dirv )     __pragma( dirv )
-#elif defined( CMN_COMPILER_MINGW )
+#elif defined( CMN_COMPILER_MINGW ) || defined( CMN_COMPILER_GCC )
     #define CMN_PRAGMA( dirv )     _Pragma( #dirv )
 #endif
 
@@ -54,7 +62,7 @@
     #define CMN_WARNING_DEFAULT_MSVC( warn )   CMN_PRAGMA( warning( default : warn ) )
     #define CMN_WARNING_DISABLE_MSVC( warn )   CMN_PRAGMA( warning( disable : warn ) )
     #define CMN_WARNING_DISABLE_GCC( warn )
-#elif defined( CMN_COMPILER_MINGW )
+#elif defined( CMN_COMPILER_MINGW ) || defined( CMN_COMPILER_GCC )
     #define CMN_WARNING_PUSH                   CMN_PRAGMA( GCC diagnostic push )
     #define CMN_WARNING_POP                    CMN_PRAGMA( GCC diagnostic pop )
 
@@ -0,0 +1,128 @@
+#ifndef __CMN_PROFILE_H__
+#define __CMN_PROFILE_H__
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Hot path instrumentation: scoped timers, counters and histograms.
+//
+//     CMN_PROFILE_SCOPE( "gtp.execute" );             // times the scope
+//     CMN_PROFILE_COUNT( "games", 1 );                // adds to a counter
+//     CMN_PROFILE_HISTOGRAM( "game.moves", moves );   // records a value
+//
+// Every thread records into slots of its own, written with relaxed atomic
+// stores and no locks; ProfileReport() sums the slots of all threads.
+// The macros compile to nothing unless CMN_PROFILE is defined to 1.
+
+namespace Cmn {
+
+    enum ProfileKind
+    {
+        PROFILE_KIND_TIMER,
+        PROFILE_KIND_COUNTER,
+        PROFILE_KIND_HISTOGRAM,
+    };
+
+    // Values are bucketed by their highest bit, bucket 0 holding zero
+    const unsigned kProfileBucketCount  = 65;
+    const unsigned kProfileMaxPoints    = 128;
+
+    // Totals of one instrumentation point since the last reset
+    struct ProfileStat
+    {
+        std::string     name;
+        ProfileKind     kind;
+        uint64_t        count;
+        uint64_t        sum;
+        uint64_t        buckets[ kProfileBucketCount ];
+
+        // Upper bound of the bucket holding the given percentile
+        uint64_t
+        GetPercentile( double percent ) const;
+    };
+
+    // Named instrumentation point, registered once per call site
+    class ProfilePoint
+    {
+    public:
+        // Adds one value: nanoseconds for timers, anything for histograms
+        void
+        Record( uint64_t value );
+
+        // Adds to a counter
+        void
+        Add( uint64_t value );
+
+    public:
+        ProfilePoint( const char * name, ProfileKind );
+
+    private:
+        unsigned    mIndex;
+    };
+
+    class ProfileTimer
+    {
+    public:
+        ProfileTimer( ProfilePoint & point )
+            : mPoint( point )
+            , mStart( std::chrono::steady_clock::now() )
+        {
+        }
+
+        ~ProfileTimer()
+        {
+            std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - mStart;
+            mPoint.Record( static_cast< uint64_t >(
+                std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ).count() ) );
+        }
+
+    private:
+        ProfilePoint &                          mPoint;
+        std::chrono::steady_clock::time_point   mStart;
+
+        ProfileTimer( const ProfileTimer & );
+        const ProfileTimer &
+        operator= ( const ProfileTimer & );
+    };
+
+    // Totals of every point used so far, sorted by name. With reset set the
+    // next call reports what has been recorded since this one.
+    void
+    GetProfileStats( std::vector< ProfileStat > &, bool reset = false );
+
+    // The same as a table, one line per point
+    std::string
+    ProfileReport( bool reset = false );
+
+} // namespace Cmn
+
+#if CMN_PROFILE
+    #define CMN_PROFILE_CONCAT2( a, b )    a ## b
+    #define CMN_PROFILE_CONCAT( a, b )     CMN_PROFILE_CONCAT2( a, b )
+    #define CMN_PROFILE_POINT( name, kind ) \
+        static Cmn::ProfilePoint CMN_PROFILE_CONCAT( cmnProfilePoint, __LINE__ )( name, kind )
+
+    #define CMN_PROFILE_SCOPE( name ) \
+        CMN_PROFILE_POINT( name, Cmn::PROFILE_KIND_TIMER ); \
+        Cmn::ProfileTimer CMN_PROFILE_CONCAT( cmnProfileTimer, __LINE__ )( CMN_PROFILE_CONCAT( cmnProfilePoint, __LINE__ ) )
+
+    #define CMN_PROFILE_COUNT( name, value ) \
+        do { \
+            CMN_PROFILE_POINT( name, Cmn::PROFILE_KIND_COUNTER ); \
+            CMN_PROFILE_CONCAT( cmnProfilePoint, __LINE__ ).Add( value ); \
+        } while ( false )
+
+    #define CMN_PROFILE_HISTOGRAM( name, value ) \
+        do { \
+            CMN_PROFILE_POINT( name, Cmn::PROFILE_KIND_HISTOGRAM ); \
+            CMN_PROFILE_CONCAT( cmnProfilePoint, __LINE__ ).Record( value ); \
+        } while ( false )
+#else
+    #define CMN_PROFILE_SCOPE( name )
+    #define CMN_PROFILE_COUNT( name, value )            do {} while ( false )
+    #define CMN_PROFILE_HISTOGRAM( name, value )        do {} while ( false )
+#endif // CMN_PROFILE
+
+#endif // __CMN_PROFILE_H__
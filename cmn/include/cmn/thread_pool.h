@@ -0,0 +1,114 @@
+#ifndef __CMN_THREAD_POOL_H__
+#define __CMN_THREAD_POOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Cmn {
+
+    // Fixed set of worker threads with a task queue each. A worker runs
+    // its own queue newest first and, once it runs dry, steals the oldest
+    // tasks of the other queues, so uneven tasks don't leave threads idle.
+    // Tasks submitted from a worker go to its own queue.
+
+    class ThreadPool
+    {
+    public:
+        typedef std::function< void() > Task;
+
+        void
+        Submit( Task );
+
+        // Blocks until every task submitted so far has finished, running
+        // queued tasks on the calling thread meanwhile. Rethrows the first
+        // exception a task has thrown. Not to be called from a task.
+        void
+        Wait();
+
+        unsigned
+        GetThreadCount() const { return static_cast< unsigned >( mThreads.size() ); }
+
+    public:
+        // Zero threads means one per hardware thread
+        ThreadPool( unsigned threadCount = 0 );
+        ~ThreadPool();
+
+    private:
+        struct Queue
+        {
+            std::mutex          mutex;
+            std::deque< Task >  tasks;
+        };
+
+        bool
+        Take( unsigned queue, Task & );
+
+        void
+        Run( Task & );
+
+        void
+        WorkerMain( unsigned index );
+
+        ThreadPool( const ThreadPool & );
+
+        ThreadPool &
+        operator= ( const ThreadPool & );
+
+    private:
+        std::vector< std::unique_ptr< Queue > > mQueues;
+        std::vector< std::thread >              mThreads;
+
+        std::mutex                  mMutex;
+        std::condition_variable     mTaskQueued;
+        std::condition_variable     mTasksDone;
+        std::atomic< size_t >       mQueuedCount;
+        std::atomic< size_t >       mPendingCount;
+        std::atomic< unsigned >     mNextQueue;
+        std::exception_ptr          mException;
+        bool                        mStop;
+    };
+
+    // Tasks of one client of a shared pool, waited for on their own: other
+    // tasks on the pool neither delay the wait nor run on the waiting
+    // thread, and exceptions of the group's tasks come back to it only.
+
+    class TaskGroup
+    {
+    public:
+        void
+        Submit( ThreadPool::Task );
+
+        // Blocks until every task of the group submitted so far has
+        // finished. Rethrows the first exception one of them has thrown.
+        // Not to be called from a task of the pool.
+        void
+        Wait();
+
+    public:
+        TaskGroup( ThreadPool & );
+        ~TaskGroup();
+
+    private:
+        TaskGroup( const TaskGroup & );
+
+        TaskGroup &
+        operator= ( const TaskGroup & );
+
+    private:
+        ThreadPool &                mPool;
+        std::mutex                  mMutex;
+        std::condition_variable     mTasksDone;
+        size_t                      mPendingCount;
+        std::exception_ptr          mException;
+    };
+
+} // namespace Cmn
+
+#endif // __CMN_THREAD_POOL_H__
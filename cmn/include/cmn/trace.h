@@ -2,15 +2,19 @@
 #define __CMN_TRACE_H__
 
 #include "cmn/platform.h"
+#include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
 
 // Software breakpoint
 
 #if CMN_DEBUG
     #if CMN_COMPILER_MSVC
         #define CMN_DEBUG_BREAK()     __debugbreak()
-    #elif CMN_COMPILER_MINGW
+    #elif CMN_COMPILER_MINGW || CMN_COMPILER_GCC
         #define CMN_DEBUG_BREAK()     asm("int $3")
     #endif // Determine the compiler
 #else
@@ -69,15 +73,18 @@
     #define CMN_ASSERT_AND( expr, var )
 #endif // CMN_DEBUG
 
-// Messages
+// Messages, one line each
 
 #define CMN_MSG( ... ) \
-    Cmn::TraceMessage( __VA_ARGS__ ); \
-    Cmn::TraceMessage( "\n" )
+    Cmn::TraceLine( Cmn::TRACE_STREAM_MESSAGE, __VA_ARGS__ )
 
 #define CMN_ERR( ... ) \
-    Cmn::TraceError( __VA_ARGS__ ); \
-    Cmn::TraceError( "\n" )
+    Cmn::TraceLine( Cmn::TRACE_STREAM_ERROR, __VA_ARGS__ )
+
+// Message formatted by the trace thread, see TraceDeferred(); takes at
+// least one argument
+#define CMN_MSG_DEFERRED( format, ... ) \
+    Cmn::TraceDeferred( Cmn::TRACE_STREAM_MESSAGE, format "\n", __VA_ARGS__ )
 
 // Exceptions
 
@@ -93,12 +100,108 @@
 
 namespace Cmn {
 
+    // Messages go to the standard output, errors to the standard error.
+    // Formatting is bounded: a message longer than the stack buffer is
+    // formatted again into a heap buffer of its size.
+    //
+    // While an AsyncTrace is alive the messages are queued on a lock free
+    // ring and written by a trace thread, so threads logging at the same
+    // time don't wait on each other or on the console. Errors are queued
+    // as well, but wait until they are written, so that an error is out
+    // before a breakpoint or a crash following it.
+
+    enum TraceStream
+    {
+        TRACE_STREAM_MESSAGE,
+        TRACE_STREAM_ERROR,
+    };
+
     // Subroutine to show a formatted message
 
     void TraceMessage( const char * format, ... );
 
     void TraceError( const char * format, ... );
 
+    // The same, with a line break appended
+    void TraceLine( TraceStream, const char * format, ... );
+
+    // Blocks until every message queued so far is written
+    void FlushTrace();
+
+    // Runs the trace thread for its lifetime; one at a time
+    class AsyncTrace
+    {
+    public:
+        AsyncTrace();
+        ~AsyncTrace();
+
+    private:
+        AsyncTrace( const AsyncTrace & );
+        const AsyncTrace &
+        operator= ( const AsyncTrace & );
+    };
+
+    // Deferred formatting: the format and the raw arguments are queued and
+    // the trace thread formats them, which keeps snprintf off the calling
+    // thread. Arguments must be scalars, and strings must outlive the
+    // message, like literals do.
+
+    const size_t kTraceInlineSize = 232;
+
+    typedef int ( * TraceFormatOp )( char * buffer, size_t size, const char * format, const void * args );
+
+    void TraceRecord( TraceStream, const char * format, TraceFormatOp, const void * args, size_t argsSize );
+
+    template < size_t... I >
+    struct TraceIndices {};
+
+    template < size_t N, size_t... I >
+    struct TraceMakeIndices : TraceMakeIndices< N - 1, N - 1, I... > {};
+
+    template < size_t... I >
+    struct TraceMakeIndices< 0, I... >
+    {
+        typedef TraceIndices< I... > Type;
+    };
+
+    template < typename... Args >
+    struct TraceAllScalar : std::true_type {};
+
+    template < typename Arg, typename... Args >
+    struct TraceAllScalar< Arg, Args... > : std::integral_constant< bool,
+        std::is_scalar< Arg >::value && TraceAllScalar< Args... >::value > {};
+
+    template < typename... Args >
+    struct TraceArgs
+    {
+        typedef std::tuple< Args... > Tuple;
+
+        static int
+        Format( char * buffer, size_t size, const char * format, const void * args )
+        {
+            typedef typename TraceMakeIndices< sizeof...( Args ) >::Type Indices;
+            return Call( buffer, size, format, *static_cast< const Tuple * >( args ), Indices() );
+        }
+
+        template < size_t... I >
+        static int
+        Call( char * buffer, size_t size, const char * format, const Tuple & args, TraceIndices< I... > )
+        {
+            return std::snprintf( buffer, size, format, std::get< I >( args )... );
+        }
+    };
+
+    template < typename... Args >
+    void TraceDeferred( TraceStream stream, const char * format, Args... args )
+    {
+        typedef TraceArgs< Args... > Packed;
+        static_assert( TraceAllScalar< Args... >::value, "Deferred trace arguments must be scalars" );
+        static_assert( sizeof( typename Packed::Tuple ) <= kTraceInlineSize, "Too many deferred trace arguments" );
+
+        typename Packed::Tuple packed( args... );
+        TraceRecord( stream, format, &Packed::Format, &packed, sizeof( packed ) );
+    }
+
 } // namespace Cmn
 
 #endif // __CMN_TRACE_H__
@@ -0,0 +1,272 @@
+#include "cmn/platform.h"
+#include "cmn/profile.h"
+#include "cmn/trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#if CMN_COMPILER_MSVC
+    #include <intrin.h>
+#endif
+
+namespace Cmn {
+
+    // Slots of one thread. Only the owning thread writes them, so plain
+    // load and store keep them consistent without locked instructions;
+    // they are atomic only for the thread reading the totals.
+
+    struct ProfileSlot
+    {
+        std::atomic< uint64_t >     count;
+        std::atomic< uint64_t >     sum;
+        std::atomic< uint64_t >     buckets[ kProfileBucketCount ];
+    };
+
+    struct ProfileThreadSlots
+    {
+        ProfileSlot     slots[ kProfileMaxPoints ];
+    };
+
+    struct ProfilePointInfo
+    {
+        const char *    name;
+        ProfileKind     kind;
+    };
+
+    // Thread slots live as long as the process: the slots of a finished
+    // thread go to the next new thread, which keeps adding to them
+
+    struct ProfileRegistry
+    {
+        std::mutex                                              mutex;
+        std::vector< ProfilePointInfo >                         points;
+        std::vector< std::unique_ptr< ProfileThreadSlots > >    threads;
+        std::vector< ProfileThreadSlots * >                     idleThreads;
+        std::vector< ProfileStat >                              baseline;
+    };
+
+    // Never destroyed, as threads may still record during exit
+    static ProfileRegistry & GetRegistry()
+    {
+        static ProfileRegistry * registry = new ProfileRegistry;
+        return *registry;
+    }
+
+    struct ProfileThread
+    {
+        ProfileThreadSlots *    slots;
+
+        ~ProfileThread()
+        {
+            if ( slots )
+            {
+                ProfileRegistry & registry = GetRegistry();
+                std::lock_guard< std::mutex > lock( registry.mutex );
+                registry.idleThreads.push_back( slots );
+            }
+        }
+    };
+
+    static thread_local ProfileThread sThread = { nullptr };
+
+    static ProfileThreadSlots & GetThreadSlots()
+    {
+        if ( !sThread.slots )
+        {
+            ProfileRegistry & registry = GetRegistry();
+            std::lock_guard< std::mutex > lock( registry.mutex );
+            if ( registry.idleThreads.empty() )
+            {
+                // Value initialisation zeroes the counters
+                registry.threads.emplace_back( new ProfileThreadSlots() );
+                sThread.slots = registry.threads.back().get();
+            }
+            else
+            {
+                sThread.slots = registry.idleThreads.back();
+                registry.idleThreads.pop_back();
+            }
+        }
+        return *sThread.slots;
+    }
+
+    static inline void Increment( std::atomic< uint64_t > & value, uint64_t delta )
+    {
+        value.store( value.load( std::memory_order_relaxed ) + delta, std::memory_order_relaxed );
+    }
+
+    static inline unsigned GetBucket( uint64_t value )
+    {
+        if ( value == 0 )
+        {
+            return 0;
+        }
+    #if CMN_COMPILER_MSVC
+        unsigned long index;
+        _BitScanReverse64( &index, value );
+        return static_cast< unsigned >( index ) + 1;
+    #else
+        return 64 - static_cast< unsigned >( __builtin_clzll( value ) );
+    #endif
+    }
+
+    uint64_t ProfileStat::GetPercentile( double percent ) const
+    {
+        uint64_t rank = static_cast< uint64_t >( std::ceil( percent / 100.0 * count ) );
+        uint64_t seen = 0;
+        for ( unsigned bucket = 0; bucket < kProfileBucketCount; ++ bucket )
+        {
+            seen += buckets[ bucket ];
+            if ( seen >= rank && seen > 0 )
+            {
+                return ( bucket == 64 ) ? UINT64_MAX : ( ( uint64_t( 1 ) << bucket ) - 1 );
+            }
+        }
+        return 0;
+    }
+
+    ProfilePoint::ProfilePoint( const char * name, ProfileKind kind )
+    {
+        ProfileRegistry & registry = GetRegistry();
+        std::lock_guard< std::mutex > lock( registry.mutex );
+
+        // Call sites sharing a name share the totals
+        for ( mIndex = 0; mIndex < registry.points.size(); ++ mIndex )
+        {
+            const ProfilePointInfo & point = registry.points[ mIndex ];
+            if ( std::strcmp( point.name, name ) == 0 )
+            {
+                CMN_ASSERT( point.kind == kind );
+                return;
+            }
+        }
+
+        CMN_ASSERT( mIndex < kProfileMaxPoints );
+        ProfilePointInfo point = { name, kind };
+        registry.points.push_back( point );
+    }
+
+    void ProfilePoint::Record( uint64_t value )
+    {
+        if ( mIndex >= kProfileMaxPoints )
+        {
+            return;
+        }
+
+        ProfileSlot & slot = GetThreadSlots().slots[ mIndex ];
+        Increment( slot.count, 1 );
+        Increment( slot.sum, value );
+        Increment( slot.buckets[ GetBucket( value ) ], 1 );
+    }
+
+    void ProfilePoint::Add( uint64_t value )
+    {
+        if ( mIndex >= kProfileMaxPoints )
+        {
+            return;
+        }
+
+        ProfileSlot & slot = GetThreadSlots().slots[ mIndex ];
+        Increment( slot.count, 1 );
+        Increment( slot.sum, value );
+    }
+
+    void GetProfileStats( std::vector< ProfileStat > & stats, bool reset /* = false */ )
+    {
+        ProfileRegistry & registry = GetRegistry();
+        std::lock_guard< std::mutex > lock( registry.mutex );
+
+        std::vector< ProfileStat > totals( registry.points.size() );
+        for ( size_t index = 0; index < totals.size(); ++ index )
+        {
+            ProfileStat & total = totals[ index ];
+            total.name  = registry.points[ index ].name;
+            total.kind  = registry.points[ index ].kind;
+            total.count = 0;
+            total.sum   = 0;
+            std::fill( total.buckets, total.buckets + kProfileBucketCount, 0 );
+
+            for ( auto & thread : registry.threads )
+            {
+                const ProfileSlot & slot = thread->slots[ index ];
+                total.count += slot.count.load( std::memory_order_relaxed );
+                total.sum   += slot.sum.load( std::memory_order_relaxed );
+                for ( unsigned bucket = 0; bucket < kProfileBucketCount; ++ bucket )
+                {
+                    total.buckets[ bucket ] += slot.buckets[ bucket ].load( std::memory_order_relaxed );
+                }
+            }
+        }
+
+        stats = totals;
+        for ( size_t index = 0; index < registry.baseline.size(); ++ index )
+        {
+            const ProfileStat & baseline = registry.baseline[ index ];
+            ProfileStat & stat = stats[ index ];
+            stat.count  -= baseline.count;
+            stat.sum    -= baseline.sum;
+            for ( unsigned bucket = 0; bucket < kProfileBucketCount; ++ bucket )
+            {
+                stat.buckets[ bucket ] -= baseline.buckets[ bucket ];
+            }
+        }
+
+        if ( reset )
+        {
+            registry.baseline.swap( totals );
+        }
+
+        std::sort( stats.begin(), stats.end(),
+            [] ( const ProfileStat & a, const ProfileStat & b ) { return a.name < b.name; } );
+    }
+
+    std::string ProfileReport( bool reset /* = false */ )
+    {
+        std::vector< ProfileStat > stats;
+        GetProfileStats( stats, reset );
+
+        std::string retval;
+        char line[ 256 ];
+
+        for ( const ProfileStat & stat : stats )
+        {
+            double count = static_cast< double >( stat.count );
+            double sum = static_cast< double >( stat.sum );
+
+            switch ( stat.kind )
+            {
+            case PROFILE_KIND_TIMER:
+                std::snprintf( line, sizeof( line ),
+                    "%-32s %10.0f calls %12.3f ms %10.3f us/call  p50 <= %.3f us  p99 <= %.3f us\n",
+                    stat.name.c_str(), count, sum * 1e-6, count ? sum * 1e-3 / count : 0.0,
+                    stat.GetPercentile( 50.0 ) * 1e-3, stat.GetPercentile( 99.0 ) * 1e-3 );
+                break;
+            case PROFILE_KIND_COUNTER:
+                std::snprintf( line, sizeof( line ),
+                    "%-32s %10.0f\n",
+                    stat.name.c_str(), sum );
+                break;
+            case PROFILE_KIND_HISTOGRAM:
+                std::snprintf( line, sizeof( line ),
+                    "%-32s %10.0f values  mean %.3f  p50 <= %.0f  p99 <= %.0f\n",
+                    stat.name.c_str(), count, count ? sum / count : 0.0,
+                    static_cast< double >( stat.GetPercentile( 50.0 ) ),
+                    static_cast< double >( stat.GetPercentile( 99.0 ) ) );
+                break;
+            default:
+                CMN_FAIL();
+                line[0] = '\0';
+            }
+
+            retval += line;
+        }
+
+        return retval;
+    }
+
+} // namespace Cmn
@@ -0,0 +1,230 @@
+#include "cmn/thread_pool.h"
+#include "cmn/trace.h"
+
+#include <algorithm>
+
+namespace Cmn {
+
+    static thread_local ThreadPool *    sWorkerPool     = nullptr;
+    static thread_local unsigned        sWorkerIndex    = 0;
+
+    ThreadPool::ThreadPool( unsigned threadCount /* = 0 */ )
+        : mQueuedCount( 0 )
+        , mPendingCount( 0 )
+        , mNextQueue( 0 )
+        , mStop( false )
+    {
+        if ( threadCount == 0 )
+        {
+            threadCount = std::max( std::thread::hardware_concurrency(), 1u );
+        }
+
+        for ( unsigned i = 0; i < threadCount; ++ i )
+        {
+            mQueues.emplace_back( new Queue );
+        }
+
+        for ( unsigned i = 0; i < threadCount; ++ i )
+        {
+            mThreads.emplace_back( &ThreadPool::WorkerMain, this, i );
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mStop = true;
+        }
+        mTaskQueued.notify_all();
+
+        for ( auto & thread : mThreads )
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::Submit( Task task )
+    {
+        unsigned queue = ( sWorkerPool == this ) ?
+            sWorkerIndex : mNextQueue.fetch_add( 1 ) % mQueues.size();
+
+        mPendingCount ++;
+        mQueuedCount ++;
+        {
+            std::lock_guard< std::mutex > lock( mQueues[ queue ]->mutex );
+            mQueues[ queue ]->tasks.push_back( std::move( task ) );
+        }
+
+        // Sleeping workers check the queued count under mMutex
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+        }
+        mTaskQueued.notify_one();
+    }
+
+    bool ThreadPool::Take( unsigned index, Task & task )
+    {
+        // Own queue from the back, then the others from the front
+        unsigned count = static_cast< unsigned >( mQueues.size() );
+        for ( unsigned i = 0; i < count; ++ i )
+        {
+            Queue & queue = *mQueues[ ( index + i ) % count ];
+            std::lock_guard< std::mutex > lock( queue.mutex );
+            if ( queue.tasks.empty() )
+            {
+                continue;
+            }
+
+            if ( i == 0 )
+            {
+                task = std::move( queue.tasks.back() );
+                queue.tasks.pop_back();
+            }
+            else
+            {
+                task = std::move( queue.tasks.front() );
+                queue.tasks.pop_front();
+            }
+
+            mQueuedCount --;
+            return true;
+        }
+
+        return false;
+    }
+
+    void ThreadPool::Run( Task & task )
+    {
+        try
+        {
+            task();
+        }
+        catch ( ... )
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            if ( !mException )
+            {
+                mException = std::current_exception();
+            }
+        }
+        task = nullptr;
+
+        if ( -- mPendingCount == 0 )
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mTasksDone.notify_all();
+        }
+    }
+
+    void ThreadPool::WorkerMain( unsigned index )
+    {
+        sWorkerPool     = this;
+        sWorkerIndex    = index;
+
+        Task task;
+        while ( true )
+        {
+            if ( Take( index, task ) )
+            {
+                Run( task );
+                continue;
+            }
+
+            std::unique_lock< std::mutex > lock( mMutex );
+            mTaskQueued.wait( lock, [ this ] { return mStop || mQueuedCount > 0; } );
+            if ( mStop && mQueuedCount == 0 )
+            {
+                return;
+            }
+        }
+    }
+
+    void ThreadPool::Wait()
+    {
+        // A task waiting for itself to finish would never return
+        CMN_ASSERT( sWorkerPool != this );
+
+        Task task;
+        while ( mPendingCount > 0 )
+        {
+            if ( Take( 0, task ) )
+            {
+                Run( task );
+                continue;
+            }
+
+            // The rest is running on the workers
+            std::unique_lock< std::mutex > lock( mMutex );
+            mTasksDone.wait( lock, [ this ] { return mPendingCount == 0; } );
+        }
+
+        std::exception_ptr exception;
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            std::swap( exception, mException );
+        }
+        if ( exception )
+        {
+            std::rethrow_exception( exception );
+        }
+    }
+
+    TaskGroup::TaskGroup( ThreadPool & pool )
+        : mPool( pool )
+        , mPendingCount( 0 )
+    {
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        // The tasks refer to the group
+        std::unique_lock< std::mutex > lock( mMutex );
+        mTasksDone.wait( lock, [ this ] { return mPendingCount == 0; } );
+    }
+
+    void TaskGroup::Submit( ThreadPool::Task task )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mPendingCount ++;
+        }
+
+        mPool.Submit( [ this, task ] {
+            std::exception_ptr exception;
+            try
+            {
+                task();
+            }
+            catch ( ... )
+            {
+                exception = std::current_exception();
+            }
+
+            std::lock_guard< std::mutex > lock( mMutex );
+            if ( exception && !mException )
+            {
+                mException = exception;
+            }
+            if ( -- mPendingCount == 0 )
+            {
+                mTasksDone.notify_all();
+            }
+        } );
+    }
+
+    void TaskGroup::Wait()
+    {
+        std::exception_ptr exception;
+        {
+            std::unique_lock< std::mutex > lock( mMutex );
+            mTasksDone.wait( lock, [ this ] { return mPendingCount == 0; } );
+            std::swap( exception, mException );
+        }
+        if ( exception )
+        {
+            std::rethrow_exception( exception );
+        }
+    }
+
+} // namespace Cmn
@@ -1,8 +1,15 @@
 #include "cmn/trace.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #if CMN_COMPILER_MSVC
     #include <windows.h>
@@ -11,28 +18,448 @@
 
 namespace Cmn {
 
-    void TraceMessage( const char * format, ... )
+    static const size_t kTraceBufferSize    = 1024;
+    static const size_t kTraceRingSize      = 1024;
+
+    // Ring slot. A message that doesn't fit in the slot is put in a heap
+    // buffer; a deferred one keeps its raw arguments in the slot instead.
+
+    struct TraceEntry
+    {
+        std::atomic< size_t >   sequence;
+        TraceStream             stream;
+        size_t                  length;
+        char *                  heapText;
+        TraceFormatOp           formatOp;
+        const char *            format;
+        union
+        {
+            char                text[ kTraceInlineSize ];
+            double              alignDouble;
+            uint64_t            alignInteger;
+            void *              alignPointer;
+        } data;
+    };
+
+    // Bounded multiple producer queue with a single consumer: every slot
+    // carries a sequence number telling whether it is free for the ticket
+    // of a producer or ready for the consumer, so producers only contend
+    // on the enqueue position.
+
+    class TraceQueue
+    {
+    public:
+        void
+        Start();
+
+        void
+        Stop();
+
+        // Null when there is no trace thread. Waits for a free slot while
+        // the ring is full.
+        TraceEntry *
+        BeginPush( size_t & ticket );
+
+        void
+        EndPush( TraceEntry *, size_t ticket );
+
+        void
+        Flush();
+
+    public:
+        TraceQueue();
+
+    private:
+        bool
+        Pop( TraceEntry *& );
+
+        void
+        Write( TraceEntry & );
+
+        void
+        ThreadMain();
+
+    private:
+        TraceEntry                  mEntries[ kTraceRingSize ];
+        std::atomic< size_t >       mEnqueuePos;
+        std::atomic< size_t >       mDequeuePos;
+        std::atomic< size_t >       mWrittenPos;
+
+        std::atomic< bool >         mRunning;
+        std::atomic< unsigned >     mProducers;
+        std::atomic< bool >         mSleeping;
+        bool                        mStop;
+
+        std::mutex                  mMutex;
+        std::condition_variable     mWake;
+        std::condition_variable     mWritten;
+        std::thread                 mThread;
+        std::vector< char >         mFormatBuffer;
+    };
+
+    // Console writes of the synchronous mode
+    static std::mutex sConsoleMutex;
+
+    // Never destroyed: messages can come from static destructors
+    static TraceQueue & GetQueue()
+    {
+        static TraceQueue * queue = new TraceQueue;
+        return *queue;
+    }
+
+    static std::ostream & GetStream( TraceStream stream )
+    {
+        return ( stream == TRACE_STREAM_ERROR ) ? std::cerr : std::cout;
+    }
+
+    TraceQueue::TraceQueue()
+        : mEnqueuePos( 0 )
+        , mDequeuePos( 0 )
+        , mWrittenPos( 0 )
+        , mRunning( false )
+        , mProducers( 0 )
+        , mSleeping( false )
+        , mStop( false )
+        , mFormatBuffer( kTraceBufferSize )
+    {
+        for ( size_t i = 0; i < kTraceRingSize; ++ i )
+        {
+            mEntries[i].sequence.store( i, std::memory_order_relaxed );
+        }
+    }
+
+    void TraceQueue::Start()
+    {
+        CMN_ASSERT( !mRunning.load() );
+
+        mStop = false;
+        mThread = std::thread( &TraceQueue::ThreadMain, this );
+        mRunning.store( true );
+    }
+
+    void TraceQueue::Stop()
+    {
+        // New messages go to the console directly; the ones being queued
+        // are waited for and written with the rest
+        mRunning.store( false );
+        while ( mProducers.load() != 0 )
+        {
+            std::this_thread::yield();
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mStop = true;
+        }
+        mWake.notify_one();
+        mThread.join();
+    }
+
+    TraceEntry * TraceQueue::BeginPush( size_t & ticket )
+    {
+        mProducers.fetch_add( 1 );
+        if ( !mRunning.load() )
+        {
+            mProducers.fetch_sub( 1 );
+            return nullptr;
+        }
+
+        size_t pos = mEnqueuePos.load( std::memory_order_relaxed );
+        while ( true )
+        {
+            TraceEntry & entry = mEntries[ pos & ( kTraceRingSize - 1 ) ];
+            size_t sequence = entry.sequence.load( std::memory_order_acquire );
+            ptrdiff_t difference = static_cast< ptrdiff_t >( sequence - pos );
+
+            if ( difference == 0 )
+            {
+                if ( mEnqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                {
+                    ticket = pos;
+                    return &entry;
+                }
+            }
+            else if ( difference < 0 )
+            {
+                // Full: let the trace thread catch up
+                mWake.notify_one();
+                std::this_thread::yield();
+                pos = mEnqueuePos.load( std::memory_order_relaxed );
+            }
+            else
+            {
+                pos = mEnqueuePos.load( std::memory_order_relaxed );
+            }
+        }
+    }
+
+    void TraceQueue::EndPush( TraceEntry * entry, size_t ticket )
+    {
+        entry->sequence.store( ticket + 1, std::memory_order_release );
+        mProducers.fetch_sub( 1 );
+
+        if ( mSleeping.load() )
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mWake.notify_one();
+        }
+    }
+
+    void TraceQueue::Flush()
+    {
+        size_t target = mEnqueuePos.load();
+
+        std::unique_lock< std::mutex > lock( mMutex );
+        mWake.notify_one();
+        while ( mRunning.load() && mWrittenPos.load() < target )
+        {
+            mWritten.wait_for( lock, std::chrono::milliseconds( 10 ) );
+        }
+    }
+
+    bool TraceQueue::Pop( TraceEntry *& retval )
+    {
+        size_t pos = mDequeuePos.load( std::memory_order_relaxed );
+        TraceEntry & entry = mEntries[ pos & ( kTraceRingSize - 1 ) ];
+        if ( entry.sequence.load( std::memory_order_acquire ) != pos + 1 )
+        {
+            return false;
+        }
+
+        retval = &entry;
+        return true;
+    }
+
+    void TraceQueue::Write( TraceEntry & entry )
+    {
+        std::ostream & stream = GetStream( entry.stream );
+
+        if ( entry.formatOp )
+        {
+            int length = entry.formatOp( mFormatBuffer.data(), mFormatBuffer.size(), entry.format, entry.data.text );
+            if ( length >= static_cast< int >( mFormatBuffer.size() ) )
+            {
+                mFormatBuffer.resize( length + 1 );
+                length = entry.formatOp( mFormatBuffer.data(), mFormatBuffer.size(), entry.format, entry.data.text );
+            }
+            if ( length > 0 )
+            {
+                stream.write( mFormatBuffer.data(), length );
+            }
+        }
+        else if ( entry.heapText )
+        {
+            stream.write( entry.heapText, entry.length );
+            delete [] entry.heapText;
+        }
+        else
+        {
+            stream.write( entry.data.text, entry.length );
+        }
+    }
+
+    void TraceQueue::ThreadMain()
+    {
+        unsigned unflushed = 0;
+
+        while ( true )
+        {
+            TraceEntry * entry = nullptr;
+            bool popped = Pop( entry );
+            if ( popped )
+            {
+                Write( *entry );
+
+                // Hand the slot to the producer one lap ahead
+                size_t pos = mDequeuePos.load( std::memory_order_relaxed );
+                entry->sequence.store( pos + kTraceRingSize, std::memory_order_release );
+                mDequeuePos.store( pos + 1, std::memory_order_relaxed );
+
+                // Flush now and then even if producers keep the ring busy,
+                // so that FlushTrace() doesn't wait for a quiet moment
+                if ( ++ unflushed < kTraceRingSize / 4 )
+                {
+                    continue;
+                }
+            }
+
+            std::cout.flush();
+            std::cerr.flush();
+            unflushed = 0;
+
+            std::unique_lock< std::mutex > lock( mMutex );
+            mWrittenPos.store( mDequeuePos.load() );
+            mWritten.notify_all();
+
+            if ( popped )
+            {
+                continue;
+            }
+
+            if ( mStop && mDequeuePos.load() == mEnqueuePos.load() )
+            {
+                break;
+            }
+
+            // A wake up can be missed between the check and the wait;
+            // the timeout covers that
+            mSleeping.store( true );
+            if ( !Pop( entry ) && !mStop )
+            {
+                mWake.wait_for( lock, std::chrono::milliseconds( 10 ) );
+            }
+            mSleeping.store( false );
+        }
+    }
+
+    // Queues or writes formatted text
+
+    static void Output( TraceStream stream, const char * text, size_t length )
     {
-        char message[ 4096 ];
+        TraceQueue & queue = GetQueue();
+
+        size_t ticket = 0;
+        TraceEntry * entry = queue.BeginPush( ticket );
+        if ( !entry )
+        {
+            std::lock_guard< std::mutex > lock( sConsoleMutex );
+            GetStream( stream ).write( text, length );
+            return;
+        }
+
+        entry->stream   = stream;
+        entry->length   = length;
+        entry->formatOp = nullptr;
+        entry->format   = nullptr;
+        if ( length <= kTraceInlineSize )
+        {
+            entry->heapText = nullptr;
+            std::memcpy( entry->data.text, text, length );
+        }
+        else
+        {
+            entry->heapText = new char[ length ];
+            std::memcpy( entry->heapText, text, length );
+        }
+        queue.EndPush( entry, ticket );
+
+        if ( stream == TRACE_STREAM_ERROR )
+        {
+            queue.Flush();
+        }
+    }
+
+    static void OutputFormatted( TraceStream stream, const char * suffix, const char * format, va_list args )
+    {
+        char buffer[ kTraceBufferSize ];
+
+        va_list argsCopy;
+        va_copy( argsCopy, args );
+        int length = std::vsnprintf( buffer, sizeof( buffer ), format, argsCopy );
+        va_end( argsCopy );
+
+        if ( length < 0 )
+        {
+            return;
+        }
 
+        size_t suffixLength = std::strlen( suffix );
+        size_t totalLength = static_cast< size_t >( length ) + suffixLength;
+        if ( totalLength < sizeof( buffer ) )
+        {
+            std::memcpy( buffer + length, suffix, suffixLength );
+            Output( stream, buffer, totalLength );
+        }
+        else
+        {
+            std::vector< char > heapBuffer( totalLength + 1 );
+            std::vsnprintf( heapBuffer.data(), length + 1, format, args );
+            std::memcpy( heapBuffer.data() + length, suffix, suffixLength );
+            Output( stream, heapBuffer.data(), totalLength );
+        }
+    }
+
+    void TraceMessage( const char * format, ... )
+    {
         va_list args;
         va_start( args, format );
-        vsprintf( message, format, args );
+        OutputFormatted( TRACE_STREAM_MESSAGE, "", format, args );
         va_end( args );
-
-        std::cout << message;
     }
 
     void TraceError( const char * format, ... )
     {
-        char message[ 4096 ];
+        va_list args;
+        va_start( args, format );
+        OutputFormatted( TRACE_STREAM_ERROR, "", format, args );
+        va_end( args );
+    }
 
+    void TraceLine( TraceStream stream, const char * format, ... )
+    {
         va_list args;
         va_start( args, format );
-        vsprintf( message, format, args );
+        OutputFormatted( stream, "\n", format, args );
         va_end( args );
+    }
+
+    void TraceRecord( TraceStream stream, const char * format, TraceFormatOp formatOp, const void * args, size_t argsSize )
+    {
+        CMN_ASSERT( argsSize <= kTraceInlineSize );
 
-        std::cerr << message;
+        TraceQueue & queue = GetQueue();
+
+        size_t ticket = 0;
+        TraceEntry * entry = queue.BeginPush( ticket );
+        if ( !entry )
+        {
+            // No trace thread: format here
+            char buffer[ kTraceBufferSize ];
+            int length = formatOp( buffer, sizeof( buffer ), format, args );
+            if ( length >= static_cast< int >( sizeof( buffer ) ) )
+            {
+                std::vector< char > heapBuffer( length + 1 );
+                formatOp( heapBuffer.data(), heapBuffer.size(), format, args );
+                Output( stream, heapBuffer.data(), length );
+            }
+            else if ( length > 0 )
+            {
+                Output( stream, buffer, length );
+            }
+            return;
+        }
+
+        entry->stream   = stream;
+        entry->length   = 0;
+        entry->heapText = nullptr;
+        entry->formatOp = formatOp;
+        entry->format   = format;
+        std::memcpy( entry->data.text, args, argsSize );
+        queue.EndPush( entry, ticket );
+
+        if ( stream == TRACE_STREAM_ERROR )
+        {
+            queue.Flush();
+        }
+    }
+
+    void FlushTrace()
+    {
+        GetQueue().Flush();
+
+        std::lock_guard< std::mutex > lock( sConsoleMutex );
+        std::cout.flush();
+        std::cerr.flush();
+    }
+
+    AsyncTrace::AsyncTrace()
+    {
+        GetQueue().Start();
+    }
+
+    AsyncTrace::~AsyncTrace()
+    {
+        GetQueue().Stop();
     }
 
-} // namespace Trace
+} // namespace Cmn
@@ -128,4 +128,13 @@
 /* Define to empty if `const' does not conform to ANSI C. */
 #undef const
 
+/* Storage class of the engine state. Every thread gets its own copy,
+ * so that several games can be played concurrently in one process.
+ */
+#if defined(_MSC_VER)
+#define GG_THREAD_LOCAL __declspec(thread)
+#else
+#define GG_THREAD_LOCAL __thread
+#endif
+
 ${PRAGMAS}
@@ -1067,7 +1067,7 @@ do_play_aftermath(int color, struct aftermath_data *a,
   disable_endgame_patterns   = 0;
 }
 
-static struct aftermath_data aftermath;
+static GG_THREAD_LOCAL struct aftermath_data aftermath;
 
 static void
 play_aftermath(int color, SGFTree *aftermath_sgftree)
@@ -1075,8 +1075,8 @@ play_aftermath(int color, SGFTree *aftermath_sgftree)
   int pos;
   struct board_state saved_board;
   struct aftermath_data *a = &aftermath;
-  static int current_board[BOARDMAX];
-  static int current_color = EMPTY;
+  static GG_THREAD_LOCAL int current_board[BOARDMAX];
+  static GG_THREAD_LOCAL int current_color = EMPTY;
   int cached_board = 1;
   gg_assert(color == BLACK || color == WHITE);
 
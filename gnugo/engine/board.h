@@ -184,33 +184,33 @@ const char *color_to_string(int color);
 /* ================================================================ */
 
 /* The board and the other parameters deciding the current position. */
-extern int          board_size;             /* board size (usually 19) */
-extern Intersection board[BOARDSIZE];       /* go board */
-extern int          board_ko_pos;
-extern int          black_captured;   /* num. of black stones captured */
-extern int          white_captured;
-
-extern Intersection initial_board[BOARDSIZE];
-extern int          initial_board_ko_pos;
-extern int          initial_white_captured;
-extern int          initial_black_captured;
-extern int          move_history_color[MAX_MOVE_HISTORY];
-extern int          move_history_pos[MAX_MOVE_HISTORY];
-extern Hash_data    move_history_hash[MAX_MOVE_HISTORY];
-extern int          move_history_pointer;
-
-extern float        komi;
-extern int          handicap;     /* used internally in chinese scoring */
-extern int          movenum;      /* movenumber - used for debug output */
+extern GG_THREAD_LOCAL int          board_size;             /* board size (usually 19) */
+extern GG_THREAD_LOCAL Intersection board[BOARDSIZE];       /* go board */
+extern GG_THREAD_LOCAL int          board_ko_pos;
+extern GG_THREAD_LOCAL int          black_captured;   /* num. of black stones captured */
+extern GG_THREAD_LOCAL int          white_captured;
+
+extern GG_THREAD_LOCAL Intersection initial_board[BOARDSIZE];
+extern GG_THREAD_LOCAL int          initial_board_ko_pos;
+extern GG_THREAD_LOCAL int          initial_white_captured;
+extern GG_THREAD_LOCAL int          initial_black_captured;
+extern GG_THREAD_LOCAL int          move_history_color[MAX_MOVE_HISTORY];
+extern GG_THREAD_LOCAL int          move_history_pos[MAX_MOVE_HISTORY];
+extern GG_THREAD_LOCAL Hash_data    move_history_hash[MAX_MOVE_HISTORY];
+extern GG_THREAD_LOCAL int          move_history_pointer;
+
+extern GG_THREAD_LOCAL float        komi;
+extern GG_THREAD_LOCAL int          handicap;     /* used internally in chinese scoring */
+extern GG_THREAD_LOCAL int          movenum;      /* movenumber - used for debug output */
 		    
-extern signed char  shadow[BOARDMAX];      /* reading tree shadow */
+extern GG_THREAD_LOCAL signed char  shadow[BOARDMAX];      /* reading tree shadow */
 
 enum suicide_rules {
   FORBIDDEN,
   ALLOWED,
   ALL_ALLOWED
 };
-extern enum suicide_rules suicide_rule;
+extern GG_THREAD_LOCAL enum suicide_rules suicide_rule;
 
 enum ko_rules {
   SIMPLE,
@@ -218,12 +218,12 @@ enum ko_rules {
   PSK,
   SSK
 };
-extern enum ko_rules ko_rule;
+extern GG_THREAD_LOCAL enum ko_rules ko_rule;
 
 
-extern int stackp;                /* stack pointer */
-extern int count_variations;      /* count (decidestring) */
-extern SGFTree *sgf_dumptree;
+extern GG_THREAD_LOCAL int stackp;                /* stack pointer */
+extern GG_THREAD_LOCAL int count_variations;      /* count (decidestring) */
+extern GG_THREAD_LOCAL SGFTree *sgf_dumptree;
 
 
 /* This struct holds the internal board state. */
@@ -252,7 +252,7 @@ struct board_state {
 /* This is increased by one anytime a move is (permanently) played or
  * the board is cleared.
  */
-extern int position_number;
+extern GG_THREAD_LOCAL int position_number;
 
 /* ================================================================ */
 /*                        board.c functions                         */
@@ -412,7 +412,7 @@ struct stats_data {
                                  /* with sufficient remaining depth. */
 };
 
-extern struct stats_data stats;
+extern GG_THREAD_LOCAL struct stats_data stats;
 
 
 /* printutils.c */
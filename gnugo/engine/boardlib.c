@@ -28,39 +28,39 @@
 #include "hash.h"
 
 /* The board state itself. */
-int          board_size = DEFAULT_BOARD_SIZE; /* board size */
-Intersection board[BOARDSIZE];
-int          board_ko_pos;
-int          white_captured;    /* number of black and white stones captured */
-int          black_captured;
+GG_THREAD_LOCAL int          board_size = DEFAULT_BOARD_SIZE; /* board size */
+GG_THREAD_LOCAL Intersection board[BOARDSIZE];
+GG_THREAD_LOCAL int          board_ko_pos;
+GG_THREAD_LOCAL int          white_captured;    /* number of black and white stones captured */
+GG_THREAD_LOCAL int          black_captured;
 
-Intersection initial_board[BOARDSIZE];
-int          initial_board_ko_pos;
-int          initial_white_captured;
-int          initial_black_captured;
-int          move_history_color[MAX_MOVE_HISTORY];
-int          move_history_pos[MAX_MOVE_HISTORY];
-Hash_data    move_history_hash[MAX_MOVE_HISTORY];
-int          move_history_pointer;
+GG_THREAD_LOCAL Intersection initial_board[BOARDSIZE];
+GG_THREAD_LOCAL int          initial_board_ko_pos;
+GG_THREAD_LOCAL int          initial_white_captured;
+GG_THREAD_LOCAL int          initial_black_captured;
+GG_THREAD_LOCAL int          move_history_color[MAX_MOVE_HISTORY];
+GG_THREAD_LOCAL int          move_history_pos[MAX_MOVE_HISTORY];
+GG_THREAD_LOCAL Hash_data    move_history_hash[MAX_MOVE_HISTORY];
+GG_THREAD_LOCAL int          move_history_pointer;
 
-float komi = 0.0;
-int handicap = 0;
-int movenum;
-enum suicide_rules suicide_rule = FORBIDDEN;
-enum ko_rules ko_rule = SIMPLE;
+GG_THREAD_LOCAL float komi = 0.0;
+GG_THREAD_LOCAL int handicap = 0;
+GG_THREAD_LOCAL int movenum;
+GG_THREAD_LOCAL enum suicide_rules suicide_rule = FORBIDDEN;
+GG_THREAD_LOCAL enum ko_rules ko_rule = SIMPLE;
 
 
-signed char shadow[BOARDMAX];
+GG_THREAD_LOCAL signed char shadow[BOARDMAX];
 
 /* Hashing of positions. */
-Hash_data board_hash;
+GG_THREAD_LOCAL Hash_data board_hash;
 
-int stackp;             /* stack pointer */
-int position_number;    /* position number */
+GG_THREAD_LOCAL int stackp;             /* stack pointer */
+GG_THREAD_LOCAL int position_number;    /* position number */
 
 /* Some statistics gathered partly in board.c and hash.c */
-struct stats_data stats;
+GG_THREAD_LOCAL struct stats_data stats;
 
 /* Variation tracking in SGF trees: */
-int count_variations  = 0;
-SGFTree *sgf_dumptree = NULL;
+GG_THREAD_LOCAL int count_variations  = 0;
+GG_THREAD_LOCAL SGFTree *sgf_dumptree = NULL;
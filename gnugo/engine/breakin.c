@@ -60,8 +60,8 @@ struct break_in_data {
 };
 
 #define MAX_BREAK_INS 50
-static struct break_in_data break_in_list[MAX_BREAK_INS];
-static int num_break_ins;
+static GG_THREAD_LOCAL struct break_in_data break_in_list[MAX_BREAK_INS];
+static GG_THREAD_LOCAL int num_break_ins;
 
 
 /* Adds all empty intersections that have two goal neighbors to the goal. */
@@ -43,21 +43,21 @@ static void tt_init(Transposition_table *table, int memsize);
 static void tt_clear(Transposition_table *table);
 
 /* The transposition table itself. */
-Transposition_table ttable;
+GG_THREAD_LOCAL Transposition_table ttable;
 
 
 /* Arrays with random numbers for Zobrist hashing of input data (other
  * than the board position). If you add an array here, do not forget
  * to also initialize it in keyhash_init() below.
  */
-static Hash_data target1_hash[BOARDMAX];
-static Hash_data target2_hash[BOARDMAX];
-static Hash_data routine_hash[NUM_CACHE_ROUTINES];
+static GG_THREAD_LOCAL Hash_data target1_hash[BOARDMAX];
+static GG_THREAD_LOCAL Hash_data target2_hash[BOARDMAX];
+static GG_THREAD_LOCAL Hash_data routine_hash[NUM_CACHE_ROUTINES];
 
 static void
 keyhash_init(void)
 {
-  static int is_initialized = 0;
+  static GG_THREAD_LOCAL int is_initialized = 0;
   
   if (!is_initialized) {
     
@@ -95,7 +95,7 @@ typedef struct {
   int is_clean;
 } Transposition_table;
 
-extern Transposition_table ttable;
+extern GG_THREAD_LOCAL Transposition_table ttable;
 
 /* Number of cache entries to use by default if no cache memory usage
  * has been set explicitly.
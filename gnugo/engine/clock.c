@@ -41,10 +41,10 @@
 #include "board.h"
 
 /* Level data */
-static int level             = DEFAULT_LEVEL; /* current level */
-static int level_offset      = 0;
-static int min_level         = 0;
-static int max_level         = gg_max(DEFAULT_LEVEL, 10);
+static GG_THREAD_LOCAL int level             = DEFAULT_LEVEL; /* current level */
+static GG_THREAD_LOCAL int level_offset      = 0;
+static GG_THREAD_LOCAL int min_level         = 0;
+static GG_THREAD_LOCAL int max_level         = gg_max(DEFAULT_LEVEL, 10);
 
 
 /*************************/
@@ -52,9 +52,9 @@ static int max_level         = gg_max(DEFAULT_LEVEL, 10);
 /*************************/
 
 /* clock parameters */
-static int main_time = -1;
-static int byoyomi_time = -1;
-static int byoyomi_stones = -1; /* <= 0 if no byo-yomi */
+static GG_THREAD_LOCAL int main_time = -1;
+static GG_THREAD_LOCAL int byoyomi_time = -1;
+static GG_THREAD_LOCAL int byoyomi_stones = -1; /* <= 0 if no byo-yomi */
 
 /* Keep track of the remaining time left.
  * If stones_left is zero, .._time_left is the remaining main time.
@@ -74,8 +74,8 @@ struct timer_data {
   int time_out;
 };
 
-static struct timer_data black_time_data;
-static struct timer_data white_time_data;
+static GG_THREAD_LOCAL struct timer_data black_time_data;
+static GG_THREAD_LOCAL struct timer_data white_time_data;
 
 
 /* Echo a time value in STANDARD format */
@@ -217,8 +217,8 @@ update_time_left(int color, int time_left, int stones)
 void
 clock_push_button(int color)
 {
-  static double last_time = -1.0;
-  static int last_movenum = -1;
+  static GG_THREAD_LOCAL double last_time = -1.0;
+  static GG_THREAD_LOCAL int last_movenum = -1;
   struct timer_data *const td
     = (color == BLACK) ? &black_time_data : &white_time_data;
   double now = gg_gettimeofday();
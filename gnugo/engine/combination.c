@@ -209,9 +209,9 @@ struct aa_move {
 };
 
 #define AA_MAX_MOVES MAX_BOARD * MAX_BOARD  
-static int aa_status[BOARDMAX]; /* ALIVE, DEAD or CRITICAL */
-static int forbidden[BOARDMAX];
-static int aa_values[BOARDMAX];
+static GG_THREAD_LOCAL int aa_status[BOARDMAX]; /* ALIVE, DEAD or CRITICAL */
+static GG_THREAD_LOCAL int forbidden[BOARDMAX];
+static GG_THREAD_LOCAL int aa_values[BOARDMAX];
 static void compute_aa_status(int color,
 			      const signed char safe_stones[BOARDMAX]);
 static void compute_aa_values(int color);
@@ -967,9 +967,9 @@ atari_atari_find_attack_moves(int color, int minsize,
 /* FIXME: Move these to a struct and pass to callback through the
  * *data parameter.
  */
-static int current_minsize;
-static struct aa_move *current_attacks;
-static int conditional_attack_point[BOARDMAX];
+static GG_THREAD_LOCAL int current_minsize;
+static GG_THREAD_LOCAL struct aa_move *current_attacks;
+static GG_THREAD_LOCAL int conditional_attack_point[BOARDMAX];
 
 static void
 atari_atari_attack_patterns(int color, int minsize,
@@ -73,15 +73,15 @@ static int compute_escape(int pos, int dragon_status_known);
 static void compute_surrounding_moyo_sizes(const struct influence_data *q);
 static void clear_cut_list(void);
 
-static int dragon2_initialized;
-static int lively_white_dragons;
-static int lively_black_dragons;
+static GG_THREAD_LOCAL int dragon2_initialized;
+static GG_THREAD_LOCAL int lively_white_dragons;
+static GG_THREAD_LOCAL int lively_black_dragons;
 
 /* This is a private array to obtain a list of worms belonging to each
  * dragon. Public access is via first_worm_in_dragon() and
  * next_worm_in_dragon().
  */
-static int next_worm_list[BOARDMAX];
+static GG_THREAD_LOCAL int next_worm_list[BOARDMAX];
 
 /* Alternative for DRAGON2 macro with asserts. */
 struct dragon_data2 *
@@ -1603,7 +1603,7 @@ show_dragons(void)
 }
 
 
-static int new_dragon_origins[BOARDMAX];
+static GG_THREAD_LOCAL int new_dragon_origins[BOARDMAX];
 
 /* Compute new dragons, e.g. after having made a move. This will not
  * affect any global state.
@@ -1842,8 +1842,8 @@ dragon_escape(signed char goal[BOARDMAX], int color,
 {
   int ii;
   int k;
-  static int mx[BOARDMAX];
-  static int mx_initialized = 0;
+  static GG_THREAD_LOCAL int mx[BOARDMAX];
+  static GG_THREAD_LOCAL int mx_initialized = 0;
   int queue[MAX_BOARD * MAX_BOARD];
   int queue_start = 0;
   int queue_end = 0;
@@ -2442,8 +2442,8 @@ struct cut_data {
   int move;
 };
 
-static int num_cuts = 0;
-static struct cut_data cut_list[MAX_CUTS];
+static GG_THREAD_LOCAL int num_cuts = 0;
+static GG_THREAD_LOCAL struct cut_data cut_list[MAX_CUTS];
 
 static void
 clear_cut_list()
@@ -49,9 +49,9 @@
 #define LOWER_RIGHT 3
 
 /* Global variables remembering which symmetries the position has. */
-static int horizontally_symmetric; /* symmetry with respect to K column */
-static int vertically_symmetric;   /* symmetry with respect to 10 row */
-static int diagonally_symmetric;   /* with respect to diagonal from UR to LL */
+static GG_THREAD_LOCAL int horizontally_symmetric; /* symmetry with respect to K column */
+static GG_THREAD_LOCAL int vertically_symmetric;   /* symmetry with respect to 10 row */
+static GG_THREAD_LOCAL int diagonally_symmetric;   /* with respect to diagonal from UR to LL */
 
 /* This value must be lower than the value for an ongoing joseki. 
  * (Gets multiplied with board_size / 19.) 
@@ -258,10 +258,10 @@ announce_move(int move, int value, int color)
 
 
 /* Storage for values collected during pattern matching. */
-static int fuseki_moves[MAX_BOARD * MAX_BOARD];
-static int fuseki_value[MAX_BOARD * MAX_BOARD];
-static int num_fuseki_moves;
-static int fuseki_total_value;
+static GG_THREAD_LOCAL int fuseki_moves[MAX_BOARD * MAX_BOARD];
+static GG_THREAD_LOCAL int fuseki_value[MAX_BOARD * MAX_BOARD];
+static GG_THREAD_LOCAL int num_fuseki_moves;
+static GG_THREAD_LOCAL int fuseki_total_value;
 
 /* Callback for fuseki database pattern matching. */
 static void
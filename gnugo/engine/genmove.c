@@ -41,19 +41,19 @@
  * will only return moves within the area marked by the array
  * search_mask.
  */
-static int limit_search = 0;
-static int search_mask[BOARDMAX];
+static GG_THREAD_LOCAL int limit_search = 0;
+static GG_THREAD_LOCAL int search_mask[BOARDMAX];
 
 static int do_genmove(int color, float pure_threat_value,
 		      int allowed_moves[BOARDMAX], float *value, int *resign);
 
 /* Position numbers for which various examinations were last made. */
-static int worms_examined = -1;
-static int initial_influence_examined = -1;
-static int dragons_examined_without_owl = -1;
-static int dragons_examined = -1;
-static int initial_influence2_examined = -1;
-static int dragons_refinedly_examined = -1;
+static GG_THREAD_LOCAL int worms_examined = -1;
+static GG_THREAD_LOCAL int initial_influence_examined = -1;
+static GG_THREAD_LOCAL int dragons_examined_without_owl = -1;
+static GG_THREAD_LOCAL int dragons_examined = -1;
+static GG_THREAD_LOCAL int initial_influence2_examined = -1;
+static GG_THREAD_LOCAL int dragons_refinedly_examined = -1;
 
 static int revise_semeai(int color);
 static int revise_thrashing_dragon(int color, float our_score,
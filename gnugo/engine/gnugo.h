@@ -49,6 +49,11 @@
 /* interface.c */
 /* Initialize the whole thing. Should be called once. */
 void init_gnugo(float memory, unsigned int random_seed);
+/* The same in two steps: the pattern tables shared by the whole process
+ * (once), and the engine state of the calling thread (once per thread).
+ */
+void init_gnugo_patterns(void);
+void init_gnugo_context(float memory, unsigned int random_seed);
 
 
 /* ================================================================ */
@@ -118,17 +123,16 @@ int gameinfo_play_sgftree(Gameinfo *gameinfo, SGFTree *tree,
 
 
 /* Miscellaneous debug options. */
-extern int quiet;		/* Minimal output. */
-extern int verbose;		/* Bore the opponent. */
-extern int allpats;		/* generate all patterns, even small ones */
-extern int printworms;		/* print full data on each string */
-extern int printmoyo;		/* print moyo board each move */
-extern int printdragons;	/* print full data on each dragon */
-extern int printboard;		/* print board each move */
-extern int showstatistics;	/* print statistics */
-extern int profile_patterns;	/* print statistics of pattern usage */
-extern char outfilename[128];	/* output file (-o option) */
-extern int output_flags;	/* amount of output to outfile */
+extern GG_THREAD_LOCAL int quiet;		/* Minimal output. */
+extern GG_THREAD_LOCAL int verbose;		/* Bore the opponent. */
+extern GG_THREAD_LOCAL int allpats;		/* generate all patterns, even small ones */
+extern GG_THREAD_LOCAL int printworms;		/* print full data on each string */
+extern GG_THREAD_LOCAL int printmoyo;		/* print moyo board each move */
+extern GG_THREAD_LOCAL int printboard;		/* print board each move */
+extern GG_THREAD_LOCAL int showstatistics;	/* print statistics */
+extern GG_THREAD_LOCAL int profile_patterns;	/* print statistics of pattern usage */
+extern GG_THREAD_LOCAL char outfilename[128];	/* output file (-o option) */
+extern GG_THREAD_LOCAL int output_flags;	/* amount of output to outfile */
 
 /* output flag bits */
 #define OUTPUT_MARKDRAGONS         0x0001  /* mark dead and critical dragons */
@@ -201,50 +205,49 @@ DEBUG_TIME                  0x4000000\n\
 "
 
 
-extern int debug;		/* debug flags */
-extern int fusekidb;            /* use fuseki database */
-extern int disable_fuseki;      /* do not generate fuseki moves */
-extern int josekidb;            /* use joseki database */
-extern int semeai_variations;   /* max variations considered reading semeai */
-extern int showtime;		/* print genmove time */
-extern int showscore;		/* print score */
-extern int chinese_rules;       /* use chinese (area) rules for counting */
-extern int experimental_owl_ext;     /* use experimental owl (GAIN/LOSS) */
-extern int experimental_connections; /* use experimental connection module */
-extern int alternate_connections;    /* use alternate connection module */
-extern int owl_threats;              /* compute owl threats */
-extern int capture_all_dead;         /* capture all dead opponent stones */
-extern int play_out_aftermath; /* make everything unconditionally settled */
-extern int resign_allowed;           /* allows GG to resign hopeless games */
-extern int play_mirror_go;           /* try to play mirror go if possible */
-extern int mirror_stones_limit;      /* but stop at this number of stones */
-extern int gtp_version;              /* version of Go Text Protocol */
-extern int use_monte_carlo_genmove;  /* use Monte Carlo move generation */
-extern int mc_games_per_level;       /* number of Monte Carlo simulations per level */
+extern GG_THREAD_LOCAL int debug;		/* debug flags */
+extern GG_THREAD_LOCAL int fusekidb;            /* use fuseki database */
+extern GG_THREAD_LOCAL int disable_fuseki;      /* do not generate fuseki moves */
+extern GG_THREAD_LOCAL int josekidb;            /* use joseki database */
+extern GG_THREAD_LOCAL int showtime;		/* print genmove time */
+extern GG_THREAD_LOCAL int showscore;		/* print score */
+extern GG_THREAD_LOCAL int chinese_rules;       /* use chinese (area) rules for counting */
+extern GG_THREAD_LOCAL int experimental_owl_ext;     /* use experimental owl (GAIN/LOSS) */
+extern GG_THREAD_LOCAL int experimental_connections; /* use experimental connection module */
+extern GG_THREAD_LOCAL int alternate_connections;    /* use alternate connection module */
+extern GG_THREAD_LOCAL int owl_threats;              /* compute owl threats */
+extern GG_THREAD_LOCAL int capture_all_dead;         /* capture all dead opponent stones */
+extern GG_THREAD_LOCAL int play_out_aftermath; /* make everything unconditionally settled */
+extern GG_THREAD_LOCAL int resign_allowed;           /* allows GG to resign hopeless games */
+extern GG_THREAD_LOCAL int play_mirror_go;           /* try to play mirror go if possible */
+extern GG_THREAD_LOCAL int mirror_stones_limit;      /* but stop at this number of stones */
+extern GG_THREAD_LOCAL int gtp_version;              /* version of Go Text Protocol */
+extern GG_THREAD_LOCAL int use_monte_carlo_genmove;  /* use Monte Carlo move generation */
+extern GG_THREAD_LOCAL int mc_games_per_level;       /* number of Monte Carlo simulations per level */
 
 /* Mandatory values of reading parameters. Normally -1, if set
  * these override the values derived from the level. */
-extern int mandated_depth;
-extern int mandated_backfill_depth;
-extern int mandated_backfill2_depth;
-extern int mandated_break_chain_depth;
-extern int mandated_superstring_depth;
-extern int mandated_fourlib_depth;
-extern int mandated_ko_depth;
-extern int mandated_branch_depth;
-extern int mandated_aa_depth;
-extern int mandated_owl_distrust_depth;
-extern int mandated_owl_branch_depth;
-extern int mandated_owl_reading_depth;
-extern int mandated_owl_node_limit; 
-extern int mandated_semeai_node_limit; 
-
-extern int autolevel_on;
-
-extern float potential_moves[BOARDMAX];
-
-extern int oracle_exists; /* oracle is available for consultation        */
-extern int metamachine;   /* use metamachine_genmove                     */
+extern GG_THREAD_LOCAL int mandated_depth;
+extern GG_THREAD_LOCAL int mandated_backfill_depth;
+extern GG_THREAD_LOCAL int mandated_backfill2_depth;
+extern GG_THREAD_LOCAL int mandated_break_chain_depth;
+extern GG_THREAD_LOCAL int mandated_superstring_depth;
+extern GG_THREAD_LOCAL int mandated_fourlib_depth;
+extern GG_THREAD_LOCAL int mandated_ko_depth;
+extern GG_THREAD_LOCAL int mandated_branch_depth;
+extern GG_THREAD_LOCAL int mandated_aa_depth;
+extern GG_THREAD_LOCAL int mandated_owl_distrust_depth;
+extern GG_THREAD_LOCAL int mandated_owl_branch_depth;
+extern GG_THREAD_LOCAL int mandated_owl_reading_depth;
+extern GG_THREAD_LOCAL int mandated_owl_node_limit; 
+extern GG_THREAD_LOCAL int mandated_semeai_node_limit; 
+
+extern GG_THREAD_LOCAL int autolevel_on;
+
+extern GG_THREAD_LOCAL float potential_moves[BOARDMAX];
+
+extern GG_THREAD_LOCAL int oracle_exists; /* oracle is available for consultation        */
+extern GG_THREAD_LOCAL int metamachine;   /* use metamachine_genmove                     */
 
 /* ================================================================ */
 /*                 tracing and debugging functions                  */
@@ -343,8 +346,13 @@ void compute_worm_influence(void);
 void make_dragons(int stop_before_owl);
 void initialize_dragon_data(void);
 void show_dragons(void);
+#ifndef __cplusplus
+/* Hidden from C++, which does not allow using an enum before its
+ * definition in liberty.h.
+ */
 enum dragon_status crude_status(int pos);
 enum dragon_status dragon_status(int pos);
+#endif
 int same_dragon(int dr1, int dr2);
 
 /* debugging functions */
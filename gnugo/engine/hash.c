@@ -45,12 +45,12 @@
 
 
 /* Random values for the board hash function. For stones and ko position. */
-static Hash_data white_hash[BOARDMAX];
-static Hash_data black_hash[BOARDMAX];
-static Hash_data ko_hash[BOARDMAX];
-static Hash_data komaster_hash[NUM_KOMASTER_STATES];
-static Hash_data kom_pos_hash[BOARDMAX];
-static Hash_data goal_hash[BOARDMAX];
+static GG_THREAD_LOCAL Hash_data white_hash[BOARDMAX];
+static GG_THREAD_LOCAL Hash_data black_hash[BOARDMAX];
+static GG_THREAD_LOCAL Hash_data ko_hash[BOARDMAX];
+static GG_THREAD_LOCAL Hash_data komaster_hash[NUM_KOMASTER_STATES];
+static GG_THREAD_LOCAL Hash_data kom_pos_hash[BOARDMAX];
+static GG_THREAD_LOCAL Hash_data goal_hash[BOARDMAX];
 
 
 /* Fill a Hashvalue with n random bits. Make use of every random bit
@@ -60,8 +60,8 @@ static Hashvalue
 hash_rand(int n)
 {
   Hashvalue h = 0;
-  static unsigned int random_bits = 0;
-  static int num_random_bits = 0;
+  static GG_THREAD_LOCAL unsigned int random_bits = 0;
+  static GG_THREAD_LOCAL int num_random_bits = 0;
   int k;
 
   while (n > 0) {
@@ -118,7 +118,7 @@ hash_init_zobrist_array(Hash_data *array, int size)
 void
 hash_init(void)
 {
-  static int is_initialized = 0;
+  static GG_THREAD_LOCAL int is_initialized = 0;
   if (is_initialized)
     return;
   
@@ -243,7 +243,7 @@ goal_to_hashvalue(const signed char *goal)
 char *
 hashdata_to_string(Hash_data *hashdata)
 {
-  static char buffer[BUFFER_SIZE];
+  static GG_THREAD_LOCAL char buffer[BUFFER_SIZE];
   int n = 0;
   int k;
 
@@ -83,7 +83,7 @@ typedef struct {
   Hashvalue hashval[NUM_HASHVALUES];
 } Hash_data;
 
-extern Hash_data board_hash;
+extern GG_THREAD_LOCAL Hash_data board_hash;
 
 Hash_data goal_to_hashvalue(const signed char *goal);
 
@@ -53,26 +53,29 @@ static void add_marked_intrusions(struct influence_data *q);
 /* Influence computed for the initial position, i.e. before making
  * some move.
  */
-struct influence_data initial_black_influence;
-struct influence_data initial_white_influence;
+GG_THREAD_LOCAL struct influence_data initial_black_influence;
+GG_THREAD_LOCAL struct influence_data initial_white_influence;
 
 /* Influence computed after some move has been made. */
-struct influence_data move_influence;
-struct influence_data followup_influence;
+GG_THREAD_LOCAL struct influence_data move_influence;
+GG_THREAD_LOCAL struct influence_data followup_influence;
+
+/* See influence.h. */
+GG_THREAD_LOCAL float cosmic_importance;
 
 /* Influence used for estimation of escape potential. */
-static struct influence_data escape_influence;
+static GG_THREAD_LOCAL struct influence_data escape_influence;
 
 /* Pointer to influence data used during pattern matching. */
-static struct influence_data *current_influence = NULL;
+static GG_THREAD_LOCAL struct influence_data *current_influence = NULL;
 
 
 /* Thresholds values used in the whose_moyo() functions */
-static struct moyo_determination_data moyo_data;
-static struct moyo_determination_data moyo_restricted_data;
+static GG_THREAD_LOCAL struct moyo_determination_data moyo_data;
+static GG_THREAD_LOCAL struct moyo_determination_data moyo_restricted_data;
  
 /* Thresholds value used in the whose_territory() function */
-static float territory_determination_value; 
+static GG_THREAD_LOCAL float territory_determination_value; 
  
 
 
@@ -93,7 +96,7 @@ static float territory_determination_value;
  * suspect to tuning.
  */
 
-static struct interpolation_data min_infl_for_territory =
+static GG_THREAD_LOCAL struct interpolation_data min_infl_for_territory =
   { 6,  0.0, 24.0, { 6.0, 15.0, 26.0, 36.0, 45.0, 50.0, 55.0 }};
 
 /* Determines the territory correction factor in dependence of the ratio
@@ -109,12 +112,12 @@ static struct interpolation_data territory_correction =
 /* If set, print influence map when computing this move. Purely for
  * debugging.
  */
-static int debug_influence = NO_MOVE;
+static GG_THREAD_LOCAL int debug_influence = NO_MOVE;
 
 /* Assigns an id to all influence computations for reference in the
  * delta territory cache.
  */
-static int influence_id = 0;
+static GG_THREAD_LOCAL int influence_id = 0;
 
 /* This is the core of the influence function. Given the coordinates
  * and color of an influence source, it radiates the influence
@@ -195,8 +198,8 @@ accumulate_influence(struct influence_data *q, int pos, int color)
   int queue_start = 0;
   int queue_end = 1;
 
-  static float working[BOARDMAX];
-  static int working_area_initialized = 0;
+  static GG_THREAD_LOCAL float working[BOARDMAX];
+  static GG_THREAD_LOCAL int working_area_initialized = 0;
 
   if (!working_area_initialized) {
     for (ii = 0; ii < BOARDMAX; ii++)
@@ -1434,7 +1437,7 @@ segment_region(struct influence_data *q, owner_function_ptr region_owner,
 	       struct moyo_data *regions)
 {
   int ii;
-  static signed char marked[BOARDMAX];
+  static GG_THREAD_LOCAL signed char marked[BOARDMAX];
   regions->number = 0;
 
   /* Reset the markings. */
@@ -1604,9 +1607,9 @@ compute_escape_influence(int color, const signed char safe_stones[BOARDMAX],
    * strength[] will currently always be identical for identical board[]
    * states. Better check for these, too.
    */
-  static int cached_board[BOARDMAX];
-  static signed char escape_values[BOARDMAX][2];
-  static int active_caches[2] = {0, 0};
+  static GG_THREAD_LOCAL int cached_board[BOARDMAX];
+  static GG_THREAD_LOCAL signed char escape_values[BOARDMAX][2];
+  static GG_THREAD_LOCAL int active_caches[2] = {0, 0};
 
   int cache_number = (color == WHITE);
 
@@ -1704,12 +1707,12 @@ compute_escape_influence(int color, const signed char safe_stones[BOARDMAX],
 
 
 /* Cache of delta_territory_values. */
-static float delta_territory_cache[BOARDMAX];
-static float followup_territory_cache[BOARDMAX];
-static Hash_data delta_territory_cache_hash[BOARDMAX];
-static int territory_cache_position_number = -1;
-static int territory_cache_influence_id = -1;
-static int territory_cache_color = -1;
+static GG_THREAD_LOCAL float delta_territory_cache[BOARDMAX];
+static GG_THREAD_LOCAL float followup_territory_cache[BOARDMAX];
+static GG_THREAD_LOCAL Hash_data delta_territory_cache_hash[BOARDMAX];
+static GG_THREAD_LOCAL int territory_cache_position_number = -1;
+static GG_THREAD_LOCAL int territory_cache_influence_id = -1;
+static GG_THREAD_LOCAL int territory_cache_color = -1;
 
 /* We cache territory computations. This avoids unnecessary re-computations
  * when review_move_reasons is run a second time for the endgame patterns.
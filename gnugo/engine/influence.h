@@ -125,7 +125,7 @@ typedef int (*owner_function_ptr)(const struct influence_data *q, int pos);
  * In the current implementation, cosmic_importance decreases 
  * slowly for 19*19 games from 1.0 at move 4 to 0.0 at move 120.
  */
-float cosmic_importance;
+extern GG_THREAD_LOCAL float cosmic_importance;
 
 
 /* Used in the whose_moyo() function */
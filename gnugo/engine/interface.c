@@ -39,6 +39,34 @@
 
 void
 init_gnugo(float memory, unsigned int seed)
+{
+  init_gnugo_patterns();
+  init_gnugo_context(memory, seed);
+}
+
+
+/*
+ * Initialize the pattern tables, which are shared by all threads.
+ * This needs to be called once only, before any engine context is
+ * used.
+ */
+
+void
+init_gnugo_patterns(void)
+{
+  transformation_init();
+  dfa_match_init();
+}
+
+
+/*
+ * Initialize the engine state of the calling thread. All engine state
+ * is thread local, so every thread playing games needs to call this
+ * once before using the engine.
+ */
+
+void
+init_gnugo_context(float memory, unsigned int seed)
 {
   /* We need a fixed seed when initializing the Zobrist hashing to get
    * reproducable results.
@@ -50,8 +78,6 @@ init_gnugo(float memory, unsigned int seed)
   persistent_cache_init();
   clear_board();
 
-  transformation_init();
-  dfa_match_init();
   choose_mc_patterns(NULL);
 
   clear_approxlib_cache();
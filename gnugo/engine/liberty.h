@@ -194,6 +194,7 @@ void fullboard_matchpat(fullboard_matchpat_callback_fn_ptr callback,
 void corner_matchpat(corner_matchpat_callback_fn_ptr callback, int color,
 		     struct corner_db *database);
 void dfa_match_init(void);
+void fixup_pattern_databases_for_board_size(void);
 
 void reading_cache_init(int bytes);
 void reading_cache_clear(void);
@@ -612,10 +613,10 @@ struct moyo_data
  * in influence.c, however!
  */
 struct influence_data;
-extern struct influence_data initial_black_influence;
-extern struct influence_data initial_white_influence;
-extern struct influence_data move_influence;
-extern struct influence_data followup_influence;
+extern GG_THREAD_LOCAL struct influence_data initial_black_influence;
+extern GG_THREAD_LOCAL struct influence_data initial_white_influence;
+extern GG_THREAD_LOCAL struct influence_data move_influence;
+extern GG_THREAD_LOCAL struct influence_data followup_influence;
 
 #define INITIAL_INFLUENCE(color) ((color) == WHITE ? \
 				    &initial_white_influence \
@@ -718,48 +719,46 @@ void move_considered(int move, float value);
 /*                         global variables                         */
 /* ================================================================ */
 
-extern int disable_threat_computation;
-extern int disable_endgame_patterns;
-extern int doing_scoring;
+extern GG_THREAD_LOCAL int disable_threat_computation;
+extern GG_THREAD_LOCAL int disable_endgame_patterns;
+extern GG_THREAD_LOCAL int doing_scoring;
 
 /* Reading parameters */
-extern int depth;               /* deep reading cutoff */
-extern int backfill_depth;      /* deep reading cutoff */
-extern int backfill2_depth;     /* deep reading cutoff */
-extern int break_chain_depth;   /* deep reading cutoff */
-extern int superstring_depth;   /* deep reading cutoff */
-extern int branch_depth;        /* deep reading cutoff */
-extern int fourlib_depth;       /* deep reading cutoff */
-extern int ko_depth;            /* deep ko reading cutoff */
-extern int aa_depth;            /* deep global reading cutoff */
-extern int depth_offset;        /* keeps track of temporary depth changes */
-extern int owl_distrust_depth;  /* below this owl trusts the optics code */
-extern int owl_branch_depth;    /* below this owl tries only one variation */
-extern int owl_reading_depth;   /* owl does not read below this depth */
-extern int owl_node_limit;      /* maximum number of nodes considered */
-extern int semeai_branch_depth;
-extern int semeai_branch_depth2;
-extern int semeai_node_limit;
-extern int connect_depth;
-extern int connect_depth2;
-extern int connection_node_limit;
-extern int breakin_depth;
-extern int breakin_node_limit;
-extern int semeai_variations;   /* max variations considered reading semeai */
-extern float best_move_values[10];
-extern int best_moves[10];
-
-extern int experimental_owl_ext;     /* use experimental owl (GAIN/LOSS) */
-extern int experimental_semeai;      /* use experimental semeai module */
-extern int experimental_connections; /* use experimental connection module */
-extern int alternate_connections;    /* use alternate connection module */
-extern int owl_threats;              /* compute owl threats */
-extern int experimental_break_in;    /* use experimental module breakin.c */
-extern int cosmic_gnugo;             /* use center oriented influence */
-extern int large_scale;              /* seek large scale captures */
-
-extern int thrashing_dragon;        /* Dead opponent's dragon trying to live */
-extern signed char thrashing_stone[BOARDMAX];       /* All thrashing stones. */
+extern GG_THREAD_LOCAL int depth;               /* deep reading cutoff */
+extern GG_THREAD_LOCAL int backfill_depth;      /* deep reading cutoff */
+extern GG_THREAD_LOCAL int backfill2_depth;     /* deep reading cutoff */
+extern GG_THREAD_LOCAL int break_chain_depth;   /* deep reading cutoff */
+extern GG_THREAD_LOCAL int superstring_depth;   /* deep reading cutoff */
+extern GG_THREAD_LOCAL int branch_depth;        /* deep reading cutoff */
+extern GG_THREAD_LOCAL int fourlib_depth;       /* deep reading cutoff */
+extern GG_THREAD_LOCAL int ko_depth;            /* deep ko reading cutoff */
+extern GG_THREAD_LOCAL int aa_depth;            /* deep global reading cutoff */
+extern GG_THREAD_LOCAL int depth_offset;        /* keeps track of temporary depth changes */
+extern GG_THREAD_LOCAL int owl_distrust_depth;  /* below this owl trusts the optics code */
+extern GG_THREAD_LOCAL int owl_branch_depth;    /* below this owl tries only one variation */
+extern GG_THREAD_LOCAL int owl_reading_depth;   /* owl does not read below this depth */
+extern GG_THREAD_LOCAL int owl_node_limit;      /* maximum number of nodes considered */
+extern GG_THREAD_LOCAL int semeai_branch_depth;
+extern GG_THREAD_LOCAL int semeai_branch_depth2;
+extern GG_THREAD_LOCAL int semeai_node_limit;
+extern GG_THREAD_LOCAL int connect_depth;
+extern GG_THREAD_LOCAL int connect_depth2;
+extern GG_THREAD_LOCAL int connection_node_limit;
+extern GG_THREAD_LOCAL int breakin_depth;
+extern GG_THREAD_LOCAL int breakin_node_limit;
+extern GG_THREAD_LOCAL float best_move_values[10];
+extern GG_THREAD_LOCAL int best_moves[10];
+
+extern GG_THREAD_LOCAL int experimental_owl_ext;     /* use experimental owl (GAIN/LOSS) */
+extern GG_THREAD_LOCAL int experimental_connections; /* use experimental connection module */
+extern GG_THREAD_LOCAL int alternate_connections;    /* use alternate connection module */
+extern GG_THREAD_LOCAL int owl_threats;              /* compute owl threats */
+extern GG_THREAD_LOCAL int experimental_break_in;    /* use experimental module breakin.c */
+extern GG_THREAD_LOCAL int cosmic_gnugo;             /* use center oriented influence */
+extern GG_THREAD_LOCAL int large_scale;              /* seek large scale captures */
+
+extern GG_THREAD_LOCAL int thrashing_dragon;        /* Dead opponent's dragon trying to live */
+extern GG_THREAD_LOCAL signed char thrashing_stone[BOARDMAX];       /* All thrashing stones. */
 
 extern int transformation[MAX_OFFSET][8];
 extern const int transformation2[8][2][2];
@@ -777,20 +776,20 @@ extern const int transformation2[8][2][2];
  * See compute_effective_worm_sizes() in worm.c for details.
  */
 #define MAX_CLOSE_WORMS 4
-extern int close_worms[BOARDMAX][MAX_CLOSE_WORMS];
-extern int number_close_worms[BOARDMAX];
-extern int close_black_worms[BOARDMAX][MAX_CLOSE_WORMS];
-extern int number_close_black_worms[BOARDMAX];
-extern int close_white_worms[BOARDMAX][MAX_CLOSE_WORMS];
-extern int number_close_white_worms[BOARDMAX];
+extern GG_THREAD_LOCAL int close_worms[BOARDMAX][MAX_CLOSE_WORMS];
+extern GG_THREAD_LOCAL int number_close_worms[BOARDMAX];
+extern GG_THREAD_LOCAL int close_black_worms[BOARDMAX][MAX_CLOSE_WORMS];
+extern GG_THREAD_LOCAL int number_close_black_worms[BOARDMAX];
+extern GG_THREAD_LOCAL int close_white_worms[BOARDMAX][MAX_CLOSE_WORMS];
+extern GG_THREAD_LOCAL int number_close_white_worms[BOARDMAX];
 
-extern int false_eye_territory[BOARDMAX];
-extern int forced_backfilling_moves[BOARDMAX];
+extern GG_THREAD_LOCAL int false_eye_territory[BOARDMAX];
+extern GG_THREAD_LOCAL int forced_backfilling_moves[BOARDMAX];
 
-extern double slowest_time;      /* Timing statistics */
-extern int slowest_move;
-extern int slowest_movenum;
-extern double total_time;
+extern GG_THREAD_LOCAL double slowest_time;      /* Timing statistics */
+extern GG_THREAD_LOCAL int slowest_move;
+extern GG_THREAD_LOCAL int slowest_movenum;
+extern GG_THREAD_LOCAL double total_time;
 
 
 struct eyevalue {
@@ -811,7 +810,7 @@ struct half_eye_data {
 };
 
 /* array of half-eye data */
-extern struct half_eye_data half_eye[BOARDMAX];
+extern GG_THREAD_LOCAL struct half_eye_data half_eye[BOARDMAX];
 
 /*
  * data concerning a worm. A copy is kept at each vertex of the worm.
@@ -856,11 +855,11 @@ struct worm_data {
   int defense_threat_codes[MAX_TACTICAL_POINTS];
 };
 
-extern struct worm_data worm[BOARDMAX];
+extern GG_THREAD_LOCAL struct worm_data worm[BOARDMAX];
 
 /* Unconditionally meaningless moves. */
-int meaningless_black_moves[BOARDMAX];
-int meaningless_white_moves[BOARDMAX];
+extern GG_THREAD_LOCAL int meaningless_black_moves[BOARDMAX];
+extern GG_THREAD_LOCAL int meaningless_white_moves[BOARDMAX];
 
 /* Surround cache (see surround.c) */
 
@@ -871,8 +870,8 @@ struct surround_data {
   signed char surround_map[BOARDMAX]; /* surround map                     */
 };
 
-extern struct surround_data surroundings[MAX_SURROUND];
-extern int surround_pointer;
+extern GG_THREAD_LOCAL struct surround_data surroundings[MAX_SURROUND];
+extern GG_THREAD_LOCAL int surround_pointer;
 
 /*
  * data concerning a dragon. A copy is kept at each stone of the string.
@@ -889,7 +888,7 @@ struct dragon_data {
   enum dragon_status status;       /* best trusted status                    */
 };
 
-extern struct dragon_data dragon[BOARDMAX];
+extern GG_THREAD_LOCAL struct dragon_data dragon[BOARDMAX];
 
 /* Supplementary data concerning a dragon. Only one copy is stored per
  * dragon in the dragon2 array.
@@ -942,8 +941,8 @@ struct dragon_data2 {
 };
 
 /* dragon2 is dynamically allocated */
-extern int number_of_dragons;
-extern struct dragon_data2 *dragon2;
+extern GG_THREAD_LOCAL int number_of_dragons;
+extern GG_THREAD_LOCAL struct dragon_data2 *dragon2;
 
 /* Macros for accessing the dragon2 data with board coordinates and
  * the dragon data with a dragon id.
@@ -957,17 +956,17 @@ struct dragon_data2 *dragon2_func(int pos);
 
 #define DRAGON(d) dragon[dragon2[d].origin]
 
-extern float white_score, black_score;
+extern GG_THREAD_LOCAL float white_score, black_score;
 
 /* Global variables to tune strategy. */
 
-extern float minimum_value_weight;
-extern float maximum_value_weight;
-extern float invasion_malus_weight;
-extern float strategical_weight;
-extern float territorial_weight;
-extern float attack_dragon_weight;
-extern float followup_weight;
+extern GG_THREAD_LOCAL float minimum_value_weight;
+extern GG_THREAD_LOCAL float maximum_value_weight;
+extern GG_THREAD_LOCAL float invasion_malus_weight;
+extern GG_THREAD_LOCAL float strategical_weight;
+extern GG_THREAD_LOCAL float territorial_weight;
+extern GG_THREAD_LOCAL float attack_dragon_weight;
+extern GG_THREAD_LOCAL float followup_weight;
 
 struct aftermath_data {
   int white_captured;
@@ -1006,17 +1005,17 @@ struct vital_eye_points {
   int defense_points[MAX_EYE_ATTACKS];
 };
 
-extern struct vital_eye_points black_vital_points[BOARDMAX];
-extern struct vital_eye_points white_vital_points[BOARDMAX];
+extern GG_THREAD_LOCAL struct vital_eye_points black_vital_points[BOARDMAX];
+extern GG_THREAD_LOCAL struct vital_eye_points white_vital_points[BOARDMAX];
 
-extern struct eye_data white_eye[BOARDMAX];
-extern struct eye_data black_eye[BOARDMAX];
+extern GG_THREAD_LOCAL struct eye_data white_eye[BOARDMAX];
+extern GG_THREAD_LOCAL struct eye_data black_eye[BOARDMAX];
 
 /* Array with the information which was previously stored in the cut
  * field and in the INHIBIT_CONNECTION bit of the type field in struct
  * eye_data.
  */
-extern int cutting_points[BOARDMAX];
+extern GG_THREAD_LOCAL int cutting_points[BOARDMAX];
 
 /* The following declarations have to be postponed until after the
  * definition of struct eye_data or struct half_eye_data.
@@ -198,7 +198,7 @@ static const int val_mask[2][8] = {
  * we care about each time.
  */
   
-static unsigned int class_mask[NUM_DRAGON_STATUS][3];
+static GG_THREAD_LOCAL unsigned int class_mask[NUM_DRAGON_STATUS][3];
 
 
 /* In the current implementation, the edge constraints depend on
@@ -519,8 +519,8 @@ matchpat_loop(matchpat_callback_fn_ptr callback, int color, int anchor,
 /* #define DFA_TRACE 1 */
 
 /* Data. */
-static int dfa_board_size = -1;
-static int dfa_p[DFA_BASE * DFA_BASE];
+static GG_THREAD_LOCAL int dfa_board_size = -1;
+static GG_THREAD_LOCAL int dfa_p[DFA_BASE * DFA_BASE];
 
 /* This is used by the EXPECTED_COLOR macro. */
 static const int convert[3][4] = {
@@ -848,6 +848,32 @@ matchpat(matchpat_callback_fn_ptr callback, int color,
                        pdb->fixed_anchor);
 }
 
+/*
+ * The pattern databases are shared by all threads, while matchpat()
+ * adapts them lazily to the board size in use. Do that for every
+ * database up front, so that threads which all play on the same board
+ * size only ever read them.
+ */
+
+void
+fixup_pattern_databases_for_board_size(void)
+{
+  static struct pattern_db *databases[] = {
+    &pat_db, &aa_attackpat_db, &owl_attackpat_db, &owl_vital_apat_db,
+    &owl_defendpat_db, &conn_db, &attpat_db, &defpat_db, &endpat_db,
+    &influencepat_db, &barrierspat_db, &fusekipat_db, &handipat_db
+  };
+  unsigned int k;
+
+  for (k = 0; k < sizeof(databases) / sizeof(databases[0]); k++) {
+    struct pattern_db *pdb = databases[k];
+    if (pdb->fixed_for_size != board_size) {
+      fixup_patterns_for_board_size(pdb->patterns);
+      pdb->fixed_for_size = board_size;
+    }
+  }
+}
+
 void 
 matchpat_goal_anchor(matchpat_callback_fn_ptr callback, int color,
 		     struct pattern_db *pdb, void *callback_data,
@@ -917,7 +943,7 @@ fullboard_matchpat(fullboard_matchpat_callback_fn_ptr callback, int color,
   int ll;   /* Iterate over transformations (rotations or reflections)  */
   /* We transform around the center point. */
   int number_of_stones_on_board = stones_on_board(BLACK | WHITE);
-  static int color_map[gg_max(WHITE, BLACK) + 1];
+  static GG_THREAD_LOCAL int color_map[gg_max(WHITE, BLACK) + 1];
   /* One hash value for each rotation/reflection: */
   Hash_data current_board_hash[8];
   
@@ -993,13 +1019,13 @@ static const int corner_y[8] = {0, 1, 1, 0, 1, 0, 0, 1};
  * However, it may be anchored at any corner of the board, so if the board is
  * small, we may calculate NUM_STONES() at negative coordinates.
  */
-static int num_stones[2*BOARDMAX];
+static GG_THREAD_LOCAL int num_stones[2*BOARDMAX];
 #define NUM_STONES(pos) num_stones[(pos) + BOARDMAX]
 
 /* Stone locations are stored in this array. They might be needed by callback
  * function.
  */
-static int pattern_stones[BOARDMAX];
+static GG_THREAD_LOCAL int pattern_stones[BOARDMAX];
 
 
 /* Recursively performs corner matching. This function checks whether
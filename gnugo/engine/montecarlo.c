@@ -926,7 +926,7 @@ struct mc_pattern_table
   unsigned int values[(NUM_GEOMETRIES + 1) * NUM_PROPERTIES];
 };
 
-static struct mc_pattern_table mc_patterns;
+static GG_THREAD_LOCAL struct mc_pattern_table mc_patterns;
 
 /* The pattern number is determined by the following bit layout:
  * 18-8: Geometry number (range 1..1107)
@@ -1034,7 +1034,7 @@ mc_init_pattern_geometries(void)
   unsigned int pattern;
   unsigned short n = 1;
 
-  static int initialized = 0;
+  static GG_THREAD_LOCAL int initialized = 0;
   if (initialized)
     return;
   initialized = 1;
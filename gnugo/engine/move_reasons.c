@@ -36,49 +36,49 @@
 
 /* All these data structures are declared in move_reasons.h */
 
-struct move_data move[BOARDMAX];
-struct move_reason move_reasons[MAX_MOVE_REASONS];
-int next_reason;
+GG_THREAD_LOCAL struct move_data move[BOARDMAX];
+GG_THREAD_LOCAL struct move_reason move_reasons[MAX_MOVE_REASONS];
+GG_THREAD_LOCAL int next_reason;
 
 /* Connections */
-int conn_worm1[MAX_CONNECTIONS];
-int conn_worm2[MAX_CONNECTIONS];
-int next_connection;
+GG_THREAD_LOCAL int conn_worm1[MAX_CONNECTIONS];
+GG_THREAD_LOCAL int conn_worm2[MAX_CONNECTIONS];
+GG_THREAD_LOCAL int next_connection;
 
 /* Potential semeai moves. */
-int semeai_target1[MAX_POTENTIAL_SEMEAI];
-int semeai_target2[MAX_POTENTIAL_SEMEAI];
-static int next_semeai;
+GG_THREAD_LOCAL int semeai_target1[MAX_POTENTIAL_SEMEAI];
+GG_THREAD_LOCAL int semeai_target2[MAX_POTENTIAL_SEMEAI];
+static GG_THREAD_LOCAL int next_semeai;
 
 /* Unordered sets (currently pairs) of move reasons / targets */
-Reason_set either_data[MAX_EITHER];
-int next_either;
-Reason_set all_data[MAX_ALL];
-int next_all;
+GG_THREAD_LOCAL Reason_set either_data[MAX_EITHER];
+GG_THREAD_LOCAL int next_either;
+GG_THREAD_LOCAL Reason_set all_data[MAX_ALL];
+GG_THREAD_LOCAL int next_all;
 
 /* Eye shapes */
-int eyes[MAX_EYES];
-int eyecolor[MAX_EYES];
-int next_eye;
+GG_THREAD_LOCAL int eyes[MAX_EYES];
+GG_THREAD_LOCAL int eyecolor[MAX_EYES];
+GG_THREAD_LOCAL int next_eye;
 
 /* Lunches */
-int lunch_dragon[MAX_LUNCHES]; /* eater */
-int lunch_worm[MAX_LUNCHES];   /* food */
-int next_lunch;
+GG_THREAD_LOCAL int lunch_dragon[MAX_LUNCHES]; /* eater */
+GG_THREAD_LOCAL int lunch_worm[MAX_LUNCHES];   /* food */
+GG_THREAD_LOCAL int next_lunch;
 
 /* Point redistribution */
-int replacement_map[BOARDMAX];
+GG_THREAD_LOCAL int replacement_map[BOARDMAX];
 
 /* The color for which we are evaluating moves. */
-int current_color;
+GG_THREAD_LOCAL int current_color;
 
 /* Attack threats that are known to be sente locally. */
-static int known_good_attack_threats[BOARDMAX][MAX_ATTACK_THREATS];
+static GG_THREAD_LOCAL int known_good_attack_threats[BOARDMAX][MAX_ATTACK_THREATS];
 
 /* Moves that are known to be safe (in the sense that played stones can
  * be captured, but opponent loses much more when attempting to do so)
  */
-static int known_safe_moves[BOARDMAX];
+static GG_THREAD_LOCAL int known_safe_moves[BOARDMAX];
 
 /* Helper functions to check conditions in discard rules. */
 typedef int (*discard_condition_fn_ptr)(int pos, int what);
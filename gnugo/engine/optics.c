@@ -95,12 +95,12 @@ static float evaluate_diagonal_intersection(int m, int n, int color,
 
 
 /* These are used during the calculations of eye spaces. */
-static int black_domain[BOARDMAX];
-static int white_domain[BOARDMAX];
+static GG_THREAD_LOCAL int black_domain[BOARDMAX];
+static GG_THREAD_LOCAL int white_domain[BOARDMAX];
 
 /* Used internally by mapping functions. */
-static int map_size;
-static signed char used_index[MAXEYE];
+static GG_THREAD_LOCAL int map_size;
+static GG_THREAD_LOCAL signed char used_index[MAXEYE];
 
 
 /*
@@ -2521,7 +2521,7 @@ eye_move_urgency(struct eyevalue *e)
 char *
 eyevalue_to_string(struct eyevalue *e)
 {
-  static char result[30];
+  static GG_THREAD_LOCAL char result[30];
   if (e->a < 10 && e->b < 10 && e->c < 10 && e->d < 10)
     gg_snprintf(result, 29, "%d%d%d%d", e->a, e->b, e->c, e->d);
   else
@@ -2864,14 +2864,14 @@ struct vertex_data {
  * non-ko vital points.
  */
 
-static int forced_ko_threat_stackp[MAX_KO_THREATS];
-static int num_active_ko_threats = 0;
+static GG_THREAD_LOCAL int forced_ko_threat_stackp[MAX_KO_THREATS];
+static GG_THREAD_LOCAL int num_active_ko_threats = 0;
 
 static int
 eyegraph_trymove(int pos, int color, const char *message, int str,
 		 struct vertex_data *vertices)
 {
-  static Hash_data remembered_board_hashes[MAXSTACK];
+  static GG_THREAD_LOCAL Hash_data remembered_board_hashes[MAXSTACK];
   int k;
   
   remembered_board_hashes[stackp] = board_hash;
@@ -103,18 +103,18 @@ struct local_owl_data {
 };
 
 
-static int result_certain;
+static GG_THREAD_LOCAL int result_certain;
 
 /* Statistics. */
-static int local_owl_node_counter;
+static GG_THREAD_LOCAL int local_owl_node_counter;
 /* Node limitation. */
-static int global_owl_node_counter = 0;
+static GG_THREAD_LOCAL int global_owl_node_counter = 0;
 
-static struct local_owl_data *current_owl_data;
-static struct local_owl_data *other_owl_data;
+static GG_THREAD_LOCAL struct local_owl_data *current_owl_data;
+static GG_THREAD_LOCAL struct local_owl_data *other_owl_data;
 
-static int goal_worms_computed = 0;
-static int owl_goal_worm[MAX_GOAL_WORMS];
+static GG_THREAD_LOCAL int goal_worms_computed = 0;
+static GG_THREAD_LOCAL int owl_goal_worm[MAX_GOAL_WORMS];
 
 
 #define MAX_CUTS 5
@@ -291,17 +291,17 @@ static void remove_eye_filling_moves(struct local_owl_data *our_owl,
 static int find_semeai_backfilling_move(int worm, int liberty);
 static int liberty_of_goal(int pos, struct local_owl_data *owl);
 static int second_liberty_of_goal(int pos, struct local_owl_data *owl);
-static int matches_found;
-static signed char found_matches[BOARDMAX];
+static GG_THREAD_LOCAL int matches_found;
+static GG_THREAD_LOCAL signed char found_matches[BOARDMAX];
 
 static void reduced_init_owl(struct local_owl_data **owl,
     			     int at_bottom_of_stack);
 static void init_owl(struct local_owl_data **owl, int target1, int target2,
 		     int move, int use_stack, int new_dragons[BOARDMAX]);
 
-static struct local_owl_data *owl_stack[2 * MAXSTACK];
-static int owl_stack_size = 0;
-static int owl_stack_pointer = 0;
+static GG_THREAD_LOCAL struct local_owl_data *owl_stack[2 * MAXSTACK];
+static GG_THREAD_LOCAL int owl_stack_size = 0;
+static GG_THREAD_LOCAL int owl_stack_pointer = 0;
 static void check_owl_stack_size(void);
 static void push_owl(struct local_owl_data **owl);
 static void do_push_owl(struct local_owl_data **owl);
@@ -318,7 +318,7 @@ static int list_goal_worms(struct local_owl_data *owl,
 /* FIXME: taken from move_reasons.h */
 #define MAX_DRAGONS       2 * MAX_BOARD * MAX_BOARD / 3
 
-static int dragon_goal_worms[MAX_DRAGONS][MAX_GOAL_WORMS];
+static GG_THREAD_LOCAL int dragon_goal_worms[MAX_DRAGONS][MAX_GOAL_WORMS];
 
 static void
 prepare_goal_list(int str, struct local_owl_data *owl,
@@ -331,12 +331,12 @@ finish_goal_list(int *flag, int *wpos, int list[MAX_GOAL_WORMS], int index);
 /* Semeai worms are worms whose capture wins the semeai. */
 
 #define MAX_SEMEAI_WORMS 20
-static int s_worms = 0;
-static int semeai_worms[MAX_SEMEAI_WORMS];
-static int important_semeai_worms[MAX_SEMEAI_WORMS];
+static GG_THREAD_LOCAL int s_worms = 0;
+static GG_THREAD_LOCAL int semeai_worms[MAX_SEMEAI_WORMS];
+static GG_THREAD_LOCAL int important_semeai_worms[MAX_SEMEAI_WORMS];
 
 /* Whether one color prefers to get a ko over a seki. */
-static int prefer_ko;
+static GG_THREAD_LOCAL int prefer_ko;
 
 /* Usually it's a bad idea to include the opponent worms involved in
  * the semeai in the eyespace. For some purposes (determining a
@@ -347,7 +347,7 @@ static int prefer_ko;
  * FIXME: We should implement a nicer mechanism to propagate this
  *        information to owl_lively(), where it's used.
  */
-static int include_semeai_worms_in_eyespace = 0;
+static GG_THREAD_LOCAL int include_semeai_worms_in_eyespace = 0;
 
 
 
@@ -2559,7 +2559,7 @@ int
 owl_defend(int target, int *defense_point, int *certain, int *kworm)
 {
   int result;
-  static struct local_owl_data *owl;
+  static GG_THREAD_LOCAL struct local_owl_data *owl;
   int reading_nodes_when_called = get_reading_node_counter();
   double start = 0.0;
   int tactical_nodes;
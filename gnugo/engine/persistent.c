@@ -145,27 +145,27 @@ static void compute_active_breakin_area(struct persistent_cache_entry *entry,
 					    breakin_shadow[BOARDMAX],
 				        int dummy);
 
-static struct persistent_cache reading_cache =
+static GG_THREAD_LOCAL struct persistent_cache reading_cache =
   { MAX_READING_CACHE_SIZE, MAX_READING_CACHE_DEPTH, 1.0,
     "reading cache", compute_active_reading_area,
     NULL, 0, -1 };
 
-static struct persistent_cache connection_cache =
+static GG_THREAD_LOCAL struct persistent_cache connection_cache =
   { MAX_CONNECTION_CACHE_SIZE, MAX_CONNECTION_CACHE_DEPTH, 1.0,
     "connection cache", compute_active_connection_area,
     NULL, 0, -1 };
 
-static struct persistent_cache breakin_cache =
+static GG_THREAD_LOCAL struct persistent_cache breakin_cache =
   { MAX_BREAKIN_CACHE_SIZE, MAX_BREAKIN_CACHE_DEPTH, 0.75,
     "breakin cache", compute_active_breakin_area,
     NULL, 0, -1 };
 
-static struct persistent_cache owl_cache =
+static GG_THREAD_LOCAL struct persistent_cache owl_cache =
   { MAX_OWL_CACHE_SIZE, MAX_OWL_CACHE_DEPTH, 1.0,
     "owl cache", compute_active_owl_area,
     NULL, 0, -1 };
 
-static struct persistent_cache semeai_cache =
+static GG_THREAD_LOCAL struct persistent_cache semeai_cache =
   { MAX_SEMEAI_CACHE_SIZE, MAX_SEMEAI_CACHE_DEPTH, 0.75,
     "semeai cache", compute_active_semeai_area,
     NULL, 0, -1 };
@@ -313,8 +313,8 @@ color_to_string(int color)
 const char *
 location_to_string(int pos)
 {
-  static int init = 0;
-  static char buf[BOARDSIZE][5];
+  static GG_THREAD_LOCAL int init = 0;
+  static GG_THREAD_LOCAL char buf[BOARDSIZE][5];
   if (!init) {
     int pos;
     for (pos = 0; pos < BOARDSIZE; pos++)
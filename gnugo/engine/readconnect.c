@@ -87,15 +87,15 @@ static int recursive_non_transitivity(int str1, int str2, int str3, int *move);
 static void order_connection_moves(int *moves, int str1, int str2,
 				   int color_to_move, const char *funcname);
 
-static int nodes_connect = 0;
+static GG_THREAD_LOCAL int nodes_connect = 0;
 
 /* Used by alternate connections. */
-static signed char connection_shadow[BOARDMAX];
+static GG_THREAD_LOCAL signed char connection_shadow[BOARDMAX];
 
-static signed char breakin_shadow[BOARDMAX]; 
+static GG_THREAD_LOCAL signed char breakin_shadow[BOARDMAX]; 
 
 /* Statistics. */
-static int global_connection_node_counter = 0;
+static GG_THREAD_LOCAL int global_connection_node_counter = 0;
 
 static void
 init_zone(zone *zn)
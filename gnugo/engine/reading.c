@@ -305,8 +305,8 @@ static int in_list(int move, int num_moves, int *moves);
 
 
 /* Statistics. */
-static int reading_node_counter = 0;
-static int nodes_when_called = 0;
+static GG_THREAD_LOCAL int reading_node_counter = 0;
+static GG_THREAD_LOCAL int nodes_when_called = 0;
 
  
 
@@ -1290,8 +1290,8 @@ fast_defense(int str, int liberties, int *libs, int *move)
    * compilers warn, quite correctly, that -1 is not an unsigned
    * number.
    */
-  static unsigned liberty_mark = ~0U;
-  static unsigned lm[BOARDMAX];
+  static GG_THREAD_LOCAL unsigned liberty_mark = ~0U;
+  static GG_THREAD_LOCAL unsigned lm[BOARDMAX];
 
   ASSERT1(libs != NULL, str);
   ASSERT1(move != NULL, str);
@@ -5044,22 +5044,22 @@ in_list(int move, int num_moves, int *moves)
  */
 
 /*                                              0   1   2   3   4  >4  */
-static int defend_lib_score[6]              = {-5, -4,  0,  3,  5, 50};
-static int defend_not_adjacent_lib_score[5] = { 0,  0,  2,  3,  5};
-static int defend_capture_score[6]          = { 0,  6,  9, 13, 18, 24};
-static int defend_atari_score[6]            = { 0,  2,  4,  6,  7, 8};
-static int defend_save_score[6]             = { 0,  3,  6,  8, 10, 12};
-static int defend_open_score[5]             = { 0,  1,  2,  3,  4};
-static int attack_own_lib_score[5]          = {10, -4,  2,  3,  4};
-static int attack_string_lib_score[6]       = {-5,  2,  3,  7, 10, 19};
-static int attack_capture_score[6]          = {-4,  4, 10, 15, 20, 25};
-static int attack_save_score[6]             = { 0, 10, 13, 18, 21, 24};
-static int attack_open_score[5]             = { 0,  0,  2,  4,  4};
-static int defend_not_edge_score            = 5;
-static int attack_not_edge_score            = 1;
-static int attack_ko_score                  = -15;
-static int cannot_defend_penalty            = -20;
-static int safe_atari_score                 = 8;
+static GG_THREAD_LOCAL int defend_lib_score[6]              = {-5, -4,  0,  3,  5, 50};
+static GG_THREAD_LOCAL int defend_not_adjacent_lib_score[5] = { 0,  0,  2,  3,  5};
+static GG_THREAD_LOCAL int defend_capture_score[6]          = { 0,  6,  9, 13, 18, 24};
+static GG_THREAD_LOCAL int defend_atari_score[6]            = { 0,  2,  4,  6,  7, 8};
+static GG_THREAD_LOCAL int defend_save_score[6]             = { 0,  3,  6,  8, 10, 12};
+static GG_THREAD_LOCAL int defend_open_score[5]             = { 0,  1,  2,  3,  4};
+static GG_THREAD_LOCAL int attack_own_lib_score[5]          = {10, -4,  2,  3,  4};
+static GG_THREAD_LOCAL int attack_string_lib_score[6]       = {-5,  2,  3,  7, 10, 19};
+static GG_THREAD_LOCAL int attack_capture_score[6]          = {-4,  4, 10, 15, 20, 25};
+static GG_THREAD_LOCAL int attack_save_score[6]             = { 0, 10, 13, 18, 21, 24};
+static GG_THREAD_LOCAL int attack_open_score[5]             = { 0,  0,  2,  4,  4};
+static GG_THREAD_LOCAL int defend_not_edge_score            = 5;
+static GG_THREAD_LOCAL int attack_not_edge_score            = 1;
+static GG_THREAD_LOCAL int attack_ko_score                  = -15;
+static GG_THREAD_LOCAL int cannot_defend_penalty            = -20;
+static GG_THREAD_LOCAL int safe_atari_score                 = 8;
 
 
 static void
@@ -5404,8 +5404,8 @@ tune_move_ordering(int params[MOVE_ORDERING_PARAMETERS])
 /* ================================================================ */
 
 
-static int safe_move_cache[BOARDMAX][2];
-static int safe_move_cache_when[BOARDMAX][2];
+static GG_THREAD_LOCAL int safe_move_cache[BOARDMAX][2];
+static GG_THREAD_LOCAL int safe_move_cache_when[BOARDMAX][2];
 static void clear_safe_move_cache(void);
 
 static void
@@ -5431,7 +5431,7 @@ int
 safe_move(int move, int color)
 {
   int safe = 0;
-  static int initialized = 0;
+  static GG_THREAD_LOCAL int initialized = 0;
   int ko_move;
   
   if (!initialized) {
@@ -112,7 +112,7 @@ sgffile_output(SGFTree *tree)
 void
 sgffile_begindump(SGFTree *tree)
 {
-  static SGFTree local_tree;
+  static GG_THREAD_LOCAL SGFTree local_tree;
   gg_assert(sgf_dumptree == NULL);
 
   if (tree == NULL)
@@ -29,6 +29,10 @@
 
 #include "liberty.h"
 
+/* Unconditionally meaningless moves, see below. */
+GG_THREAD_LOCAL int meaningless_black_moves[BOARDMAX];
+GG_THREAD_LOCAL int meaningless_white_moves[BOARDMAX];
+
 /* Capture as many strings of the given color as we can. Played stones
  * are left on the board and the number of played stones is returned.
  * Strings marked in the exceptions array are excluded from capturing
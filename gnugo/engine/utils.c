@@ -908,7 +908,7 @@ breakin_node_limit: %d\n\n",
 }
 
 
-static int depth_modification = 0;
+static GG_THREAD_LOCAL int depth_modification = 0;
 
 /*
  * Modify the various tactical reading depth parameters. This is
@@ -1916,7 +1916,7 @@ superstring_add_string(int str,
 
 /* Internal timers for assessing time spent on various tasks. */
 #define NUMBER_OF_TIMERS 4
-static double timers[NUMBER_OF_TIMERS];
+static GG_THREAD_LOCAL double timers[NUMBER_OF_TIMERS];
 
 /* Start a timer. */
 void
@@ -588,7 +588,7 @@ do_compute_effective_worm_sizes(int color, int (*cw)[MAX_CLOSE_WORMS],
    * worms may potentially be equally close, but no more than
    * 2*(board_size-1).
    */
-  static int worms[BOARDMAX][2*(MAX_BOARD-1)];
+  static GG_THREAD_LOCAL int worms[BOARDMAX][2*(MAX_BOARD-1)];
   int nworms[BOARDMAX];   /* number of equally close worms */
   int found_one;
   int dist; /* current distance */
@@ -738,7 +738,7 @@ find_worm_attacks_and_defenses()
   int acode, dcode;
   int attack_point;
   int defense_point;
-  static int libs[MAXLIBS];
+  static GG_THREAD_LOCAL int libs[MAXLIBS];
   int liberties;
   int color;
   int other;
@@ -875,7 +875,7 @@ static void
 find_worm_threats()
 {
   int str;
-  static int libs[MAXLIBS];
+  static GG_THREAD_LOCAL int libs[MAXLIBS];
   int liberties;
   
   int k;
@@ -483,7 +483,7 @@ dummyhelper(int transformation, int move, int color, int action)
 static int fatal_errors = 0;
 
 /* options */
-int verbose = 0;	       /* -v */
+GG_THREAD_LOCAL int verbose = 0; /* -v */
 static int database_type = 0;  /* -p (default), -c, -f, -C, -D or -T */
 static int anchor = 0; 	       /* Whether both O and/or X may be anchors.
 				* -b for both. -X for only X.
@@ -503,7 +503,7 @@ inv_rotate(int i, int j, int *ri, int *rj, int bs, int rot)
  */
  
 /* Private variable remembering the random seed. */
-static unsigned int random_seed;
+static GG_THREAD_LOCAL unsigned int random_seed;
 
 unsigned int
 get_random_seed()
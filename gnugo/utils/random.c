@@ -21,6 +21,8 @@
  * Boston, MA 02111, USA.                                            *
 \* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#include <config.h>
+
 #include <limits.h>
 #include <assert.h>
 
@@ -51,12 +53,12 @@ static const unsigned int c = 0xdb8b0000U;
 
 
 /* Global state for the random number generator. */
-static unsigned int x[N];
-static int k;
+static GG_THREAD_LOCAL unsigned int x[N];
+static GG_THREAD_LOCAL int k;
 
 
 /* Set when properly seeded. */
-static int rand_initialized = 0;
+static GG_THREAD_LOCAL int rand_initialized = 0;
 
 /* We use this to detect whether unsigned ints are bigger than 32
  * bits. If they are we need to clear higher order bits, otherwise we
@@ -0,0 +1,361 @@
+#include "ann/network.h"
+#include "ann/perceptron_genetic_algorithm_trainer.h"
+#include "bench/report.h"
+#include "cmn/platform.h"
+#include "cmn/thread_pool.h"
+#include "cmn/trace.h"
+#include "gnugo/engine_pool.h"
+#include "gnugo/game.h"
+#include "gnugo/gtp_engine.h"
+#include "gnugo/player.h"
+#include "gnugo/player_ann.h"
+#include "gnugo/player_random.h"
+#include "gnugo/reply_cache.h"
+#include "go/board.h"
+#include "training/fitness_scheduler.h"
+#include "training/generation_evaluator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <random>
+#include <string>
+#include <thread>
+
+// Measures the trainer's hot paths and writes the results as JSON:
+//
+//     trainer-bench [output file] [games per measurement]
+//
+// Progress goes to the standard output, results to bench.json by default.
+
+const unsigned kBoardSize       = 9;
+const unsigned kCellCount       = kBoardSize * kBoardSize;
+const unsigned kLevel           = 1;
+const unsigned kCommandCount    = 200;
+const unsigned kComputeCount    = 10000;
+const unsigned kPopulationSize  = 4;
+const unsigned kRoundGameCount  = 5;
+const unsigned kInferenceBatchSize = 8;
+
+// Times every move of the network player; the move includes passing it to
+// the engine, as it does in training
+
+class TimedPlayerAnn : public gnugo::PlayerAnn
+{
+public:
+    go::Move
+    MakeMove( const go::Board & board )
+    {
+        bench::Clock::time_point start = bench::Clock::now();
+        go::Move move = gnugo::PlayerAnn::MakeMove( board );
+        mSamples.push_back( bench::SecondsSince( start ) * 1e6 );
+        return move;
+    }
+
+public:
+    TimedPlayerAnn( ANN::ConstINetworkIn network, gnugo::Engine & engine, std::vector< double > & samples )
+        : gnugo::PlayerAnn( network, engine )
+        , mSamples( samples )
+    {
+    }
+
+private:
+    std::vector< double > & mSamples;
+};
+
+// Round trip of every GTP command the trainer sends. Black plays random
+// legal moves and white asks the engine, so play, genmove and list_stones
+// are measured on positions of real games.
+
+static void BenchGtp( bench::Report & report )
+{
+    CMN_MSG( "GTP commands" );
+
+    gnugo::GtpEngine engine( kLevel, kBoardSize, 1 );
+
+    report.AddSamples( "gtp.name", "us",
+        bench::Measure( kCommandCount, [ &engine ] { engine.Execute( "name" ); } ) );
+    report.AddSamples( "gtp.clear_board", "us",
+        bench::Measure( kCommandCount, [ &engine ] { engine.ClearBoard(); } ) );
+
+    std::vector< double > play, genmove, listStones, finalScore;
+    std::default_random_engine random( 1 );
+    go::Board board( kBoardSize );
+    std::vector< bool > legalMoves;
+    std::vector< unsigned > candidates;
+
+    while ( play.size() < kCommandCount )
+    {
+        engine.ClearBoard();
+        board.Clear();
+
+        for ( unsigned moveIndex = 0; moveIndex < kCellCount; ++ moveIndex )
+        {
+            // Black: random legal move, passing only when it has to
+            board.GetLegalMoves( go::COLOR_BLACK, legalMoves );
+            candidates.clear();
+            for ( unsigned point = 0; point < kCellCount; ++ point )
+            {
+                if ( legalMoves[ point ] )
+                {
+                    candidates.push_back( point );
+                }
+            }
+            if ( candidates.empty() )
+            {
+                break;
+            }
+
+            unsigned point = candidates[ random() % candidates.size() ];
+            go::Move move;
+            move.type   = go::MOVE_TYPE_PLACE;
+            move.row    = point / kBoardSize;
+            move.column = point % kBoardSize;
+
+            bench::Clock::time_point start = bench::Clock::now();
+            bool played = engine.Play( go::COLOR_BLACK, move );
+            play.push_back( bench::SecondsSince( start ) * 1e6 );
+            CMN_ASSERT( played ); CMN_UNUSED( played );
+            board.Play( go::COLOR_BLACK, move );
+
+            // White: engine's move
+            start = bench::Clock::now();
+            move = engine.Genmove( go::COLOR_WHITE );
+            genmove.push_back( bench::SecondsSince( start ) * 1e6 );
+            if ( move.type == go::MOVE_TYPE_PASS )
+            {
+                break;
+            }
+            board.Play( go::COLOR_WHITE, move );
+
+            std::list< go::Stone > stones;
+            start = bench::Clock::now();
+            engine.ListStones( stones, go::COLOR_BLACK );
+            listStones.push_back( bench::SecondsSince( start ) * 1e6 );
+        }
+
+        bench::Clock::time_point start = bench::Clock::now();
+        engine.GetScore( go::COLOR_WHITE );
+        finalScore.push_back( bench::SecondsSince( start ) * 1e6 );
+    }
+
+    report.AddSamples( "gtp.play", "us", play );
+    report.AddSamples( "gtp.genmove", "us", genmove );
+    report.AddSamples( "gtp.list_stones", "us", listStones );
+    report.AddSamples( "gtp.final_score", "us", finalScore );
+}
+
+// Whole games against a GNU Go engine reused between games, the way the
+// trainer's engine pool reuses them
+
+typedef std::function< void( gnugo::Engine &, unsigned game ) > GameOp;
+
+static void BenchGames( bench::Report & report, const std::string & name, unsigned gameCount, const GameOp & playGame )
+{
+    CMN_MSG( "Games %s", name.c_str() );
+
+    gnugo::GtpEngine engine( kLevel, kBoardSize, 1 );
+
+    std::vector< double > durations;
+    bench::Clock::time_point start = bench::Clock::now();
+    for ( unsigned game = 0; game < gameCount; ++ game )
+    {
+        bench::Clock::time_point gameStart = bench::Clock::now();
+        playGame( engine, game );
+        durations.push_back( bench::SecondsSince( gameStart ) * 1e3 );
+    }
+    double seconds = bench::SecondsSince( start );
+
+    report.AddSamples( "game." + name, "ms", durations );
+    report.AddValue( "games_per_second." + name, "games/s", gameCount / seconds );
+}
+
+// Network evaluation alone, on random positions
+
+static void BenchInference( bench::Report & report, ANN::ConstINetworkIn network )
+{
+    CMN_MSG( "Network inference" );
+
+    std::default_random_engine random( 1 );
+    std::vector< std::vector< double > > positions( 64, std::vector< double >( kCellCount ) );
+    for ( auto & inputs : positions )
+    {
+        for ( double & input : inputs )
+        {
+            input = static_cast< double >( static_cast< int >( random() % 3 ) - 1 );
+        }
+    }
+
+    unsigned index = 0;
+    volatile double sink = 0.0;
+    report.AddSamples( "player_ann.compute", "us",
+        bench::Measure( kComputeCount,
+            [ & ] {
+                std::vector< double > outputs = network->Compute( positions[ index ++ % positions.size() ] );
+                sink = outputs[0];
+            } ) );
+    CMN_UNUSED( sink );
+}
+
+static double NullFitnessOp( ANN::ConstPerceptronIn )
+{
+    return 0.0;
+}
+
+// The generation evaluated twice on a pool of its own, first with an empty
+// reply cache, then with the replies of the first pass cached
+
+static void BenchGenerationPasses( bench::Report & report, const training::GenerationEvaluator::Settings & settings,
+                                   unsigned threadCount, const std::vector< ANN::ConstPerceptronRef > & generation,
+                                   unsigned eliteCount )
+{
+    std::string backend = settings.nativeEngine ? "native" : "gtp";
+    if ( settings.inferenceBatchSize > 0 )
+    {
+        backend += "_batched";
+    }
+
+    Cmn::ThreadPool                 pool( threadCount );
+    training::FitnessScheduler      scheduler( pool );
+    gnugo::EnginePool               engines;
+    gnugo::ReplyCache               replyCache;
+    training::GenerationEvaluator   evaluator( settings, scheduler, engines, replyCache );
+
+    std::string name = "generation." + backend + ".threads_" + std::to_string( threadCount );
+    for ( const char * pass : { "cold", "warm" } )
+    {
+        CMN_MSG( "Generation, %s engines on %u threads, %s reply cache", backend.c_str(), threadCount, pass );
+
+        std::vector< double > fitness;
+        bench::Clock::time_point start = bench::Clock::now();
+        unsigned playedCount = evaluator.Evaluate( generation, eliteCount, fitness );
+        double seconds = bench::SecondsSince( start );
+
+        report.AddValue( name + "." + pass, "ms", seconds * 1e3 );
+        report.AddValue( name + "." + pass + ".games_per_second", "games/s", playedCount / seconds );
+    }
+    report.AddValue( name + ".replies_cached", "replies", static_cast< double >( replyCache.GetSize() ) );
+}
+
+// One generation evaluated the way the trainer does it, through
+// training::GenerationEvaluator: reply cache, scorer and racing for the
+// elite, for both GNU Go backends and a number of pool sizes, then with
+// inference batching. Each run starts from an empty reply cache, then
+// evaluates the same generation again with the replies of the first pass
+// cached. The fitness cache stays off, or the second pass would play
+// nothing.
+
+static void BenchGeneration( bench::Report & report, unsigned gameCount )
+{
+    std::vector< ANN::ConstPerceptronRef > generation;
+    Cmn::ThreadPool trainerPool;
+    ANN::IPerceptronGeneticAlgorithmTrainerRef trainer =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( NullFitnessOp, kCellCount, kCellCount + 1, kPopulationSize, trainerPool );
+    trainer->SetGenerationFitnessOp(
+        [ &generation ] ( const std::vector< ANN::ConstPerceptronRef > & individuals, std::vector< double > & fitness ) {
+            generation = individuals;
+            fitness.assign( individuals.size(), 0.0 );
+        } );
+    trainer->Step();
+    unsigned eliteCount = trainer->GetEliteCount();
+
+    training::GenerationEvaluator::Settings settings;
+    settings.boardSize      = kBoardSize;
+    settings.level          = kLevel;
+    settings.gameCount      = gameCount;
+    settings.roundGameCount = kRoundGameCount;
+
+    std::vector< unsigned > threadCounts;
+    unsigned hardwareThreads = std::max( std::thread::hardware_concurrency(), 1u );
+    for ( unsigned threadCount = 1; threadCount < hardwareThreads; threadCount *= 2 )
+    {
+        threadCounts.push_back( threadCount );
+    }
+    threadCounts.push_back( hardwareThreads );
+
+    for ( bool nativeEngine : { false, true } )
+    {
+        settings.nativeEngine = nativeEngine;
+        for ( unsigned threadCount : threadCounts )
+        {
+            BenchGenerationPasses( report, settings, threadCount, generation, eliteCount );
+        }
+    }
+
+    // Inference batching is opt-in in the trainer; measured on all threads
+    settings.inferenceBatchSize = kInferenceBatchSize;
+    BenchGenerationPasses( report, settings, hardwareThreads, generation, eliteCount );
+}
+
+int main( int argc, char * argv[] )
+{
+    std::string outputPath = ( argc > 1 ) ? argv[1] : "bench.json";
+    unsigned gameCount = ( argc > 2 ) ? static_cast< unsigned >( std::atoi( argv[2] ) ) : 10;
+    if ( gameCount == 0 )
+    {
+        CMN_MSG( "Usage: %s [output file] [games per measurement]", argv[0] );
+        return 1;
+    }
+
+    bench::Report report;
+#if CMN_DEBUG
+    report.AddContext( "build", "debug" );
+#else
+    report.AddContext( "build", "release" );
+#endif
+    report.AddContext( "hardware_threads", std::thread::hardware_concurrency() );
+    report.AddContext( "board_size", kBoardSize );
+    report.AddContext( "gnugo_level", kLevel );
+    report.AddContext( "game_count", gameCount );
+
+    // Any individual of a fresh population will do for timing
+    Cmn::ThreadPool pool;
+    ANN::IPerceptronGeneticAlgorithmTrainerRef trainer =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( NullFitnessOp, kCellCount, kCellCount + 1, kPopulationSize, pool );
+    trainer->Step();
+    ANN::ConstPerceptronRef network = trainer->GetFittest();
+
+    BenchGtp( report );
+
+    BenchGames( report, "gnugo_vs_gnugo", gameCount,
+        [] ( gnugo::Engine & engine, unsigned ) {
+            gnugo::Player   blackPlayer( engine );
+            gnugo::Player   whitePlayer( engine );
+            gnugo::Game     game( kBoardSize, blackPlayer, whitePlayer, engine );
+            game.Play();
+        } );
+
+    BenchGames( report, "random_vs_gnugo", gameCount,
+        [] ( gnugo::Engine & engine, unsigned gameIndex ) {
+            gnugo::PlayerRandom blackPlayer( engine, gameIndex + 1 );
+            gnugo::Player       whitePlayer( engine );
+            gnugo::Game         game( kBoardSize, blackPlayer, whitePlayer, engine );
+            game.Play();
+        } );
+
+    std::vector< double > makeMove;
+    BenchGames( report, "ann_vs_gnugo", gameCount,
+        [ &network, &makeMove ] ( gnugo::Engine & engine, unsigned ) {
+            TimedPlayerAnn  blackPlayer( network, engine, makeMove );
+            gnugo::Player   whitePlayer( engine );
+            gnugo::Game     game( kBoardSize, blackPlayer, whitePlayer, engine );
+            game.Play();
+        } );
+    report.AddSamples( "player_ann.make_move", "us", makeMove );
+
+    BenchInference( report, network );
+    BenchGeneration( report, gameCount );
+
+    std::ofstream stream( outputPath );
+    report.Write( stream );
+    if ( !stream )
+    {
+        CMN_MSG( "Failed to write %s", outputPath.c_str() );
+        return 1;
+    }
+
+    CMN_MSG( "Results written to %s", outputPath.c_str() );
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "bench/report.h"
+#include "cmn/trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace bench {
+
+    static std::string Quote( const std::string & text )
+    {
+        std::string retval = "\"";
+        for ( char c : text )
+        {
+            if ( c == '"' || c == '\\' )
+            {
+                retval.push_back( '\\' );
+            }
+            retval.push_back( c );
+        }
+        retval.push_back( '"' );
+        return retval;
+    }
+
+    static std::string Number( double value )
+    {
+        if ( !std::isfinite( value ) )
+        {
+            return "null";
+        }
+
+        char buffer[ 32 ];
+        std::snprintf( buffer, sizeof( buffer ), "%.6g", value );
+        return buffer;
+    }
+
+    // Nearest rank percentile of sorted samples
+    static double Percentile( const std::vector< double > & sorted, double percent )
+    {
+        CMN_ASSERT( !sorted.empty() );
+        size_t rank = static_cast< size_t >( std::ceil( percent / 100.0 * sorted.size() ) );
+        return sorted[ std::max< size_t >( rank, 1 ) - 1 ];
+    }
+
+    double SecondsSince( Clock::time_point start )
+    {
+        return std::chrono::duration< double >( Clock::now() - start ).count();
+    }
+
+    std::vector< double > Measure( unsigned iterations, const std::function< void() > & op )
+    {
+        std::vector< double > retval;
+        retval.reserve( iterations );
+
+        for ( unsigned i = 0; i < iterations; ++ i )
+        {
+            Clock::time_point start = Clock::now();
+            op();
+            retval.push_back( SecondsSince( start ) * 1e6 );
+        }
+
+        return retval;
+    }
+
+    Report::Report()
+    {
+    }
+
+    Report::~Report()
+    {
+    }
+
+    void Report::AddValue( const std::string & name, const std::string & unit, double value )
+    {
+        Result result;
+        result.name     = name;
+        result.unit     = unit;
+        result.single   = true;
+        result.samples.push_back( value );
+        mResults.push_back( result );
+    }
+
+    void Report::AddSamples( const std::string & name, const std::string & unit, std::vector< double > samples )
+    {
+        CMN_ASSERT( !samples.empty() );
+
+        Result result;
+        result.name     = name;
+        result.unit     = unit;
+        result.single   = false;
+        result.samples.swap( samples );
+        mResults.push_back( result );
+    }
+
+    void Report::AddContext( const std::string & name, const std::string & value )
+    {
+        Context context = { name, value, true };
+        mContext.push_back( context );
+    }
+
+    void Report::AddContext( const std::string & name, double value )
+    {
+        Context context = { name, Number( value ), false };
+        mContext.push_back( context );
+    }
+
+    void Report::Write( std::ostream & stream ) const
+    {
+        stream << "{\n    \"context\": {";
+        for ( size_t i = 0; i < mContext.size(); ++ i )
+        {
+            const Context & context = mContext[i];
+            stream << ( i ? ",\n" : "\n" ) << "        " << Quote( context.name ) << ": "
+                   << ( context.quoted ? Quote( context.value ) : context.value );
+        }
+        stream << "\n    },\n    \"results\": [";
+
+        for ( size_t i = 0; i < mResults.size(); ++ i )
+        {
+            const Result & result = mResults[i];
+            stream << ( i ? ",\n" : "\n" ) << "        { "
+                   << "\"name\": " << Quote( result.name ) << ", "
+                   << "\"unit\": " << Quote( result.unit ) << ", ";
+
+            if ( result.single )
+            {
+                stream << "\"value\": " << Number( result.samples[0] );
+            }
+            else
+            {
+                std::vector< double > sorted( result.samples );
+                std::sort( sorted.begin(), sorted.end() );
+
+                double sum = 0.0;
+                for ( double sample : sorted )
+                {
+                    sum += sample;
+                }
+
+                stream << "\"count\": " << sorted.size() << ", "
+                       << "\"mean\": " << Number( sum / sorted.size() ) << ", "
+                       << "\"min\": " << Number( sorted.front() ) << ", "
+                       << "\"median\": " << Number( Percentile( sorted, 50.0 ) ) << ", "
+                       << "\"p90\": " << Number( Percentile( sorted, 90.0 ) ) << ", "
+                       << "\"max\": " << Number( sorted.back() );
+            }
+
+            stream << " }";
+        }
+
+        stream << "\n    ]\n}\n";
+    }
+
+} // namespace bench
@@ -0,0 +1,74 @@
+#ifndef __BENCH_REPORT_H__
+#define __BENCH_REPORT_H__
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    typedef std::chrono::steady_clock Clock;
+
+    // Seconds passed since the given time point
+    double
+    SecondsSince( Clock::time_point );
+
+    // Runs the operation the given number of times and returns the duration
+    // of every run, in microseconds
+    std::vector< double >
+    Measure( unsigned iterations, const std::function< void() > & );
+
+    // Benchmark results of one run, written out as JSON so that runs of
+    // different builds can be compared by scripts. Every result is either
+    // a single value or a summary of samples: count, mean, min, median,
+    // 90th percentile and max.
+
+    class Report
+    {
+    public:
+        void
+        AddValue( const std::string & name, const std::string & unit, double value );
+
+        void
+        AddSamples( const std::string & name, const std::string & unit, std::vector< double > samples );
+
+        // Describes the run itself: build, machine, parameters
+        void
+        AddContext( const std::string & name, const std::string & value );
+
+        void
+        AddContext( const std::string & name, double value );
+
+        void
+        Write( std::ostream & ) const;
+
+    public:
+        Report();
+        ~Report();
+
+    private:
+        struct Result
+        {
+            std::string             name;
+            std::string             unit;
+            std::vector< double >   samples;
+            bool                    single;
+        };
+
+        struct Context
+        {
+            std::string             name;
+            std::string             value;
+            bool                    quoted;
+        };
+
+    private:
+        std::vector< Result >       mResults;
+        std::vector< Context >      mContext;
+    };
+
+} // namespace bench
+
+#endif // __BENCH_REPORT_H__
@@ -0,0 +1,136 @@
+#include "cmn/profile.h"
+#include "cmn/trace.h"
+#include "gnugo/caching_engine.h"
+#include "gnugo/reply_cache.h"
+
+namespace gnugo {
+
+    CachingEngine::CachingEngine( Engine & engine, ReplyCache & cache, unsigned seed )
+        : Engine( engine.GetLevel(), engine.GetBoardSize() )
+        , mEngine( engine )
+        , mCache( cache )
+        , mSeed( seed )
+        , mBoard( engine.GetBoardSize() )
+        , mSynced( false )
+    {
+        mCaptures[ go::COLOR_BLACK ] = 0;
+        mCaptures[ go::COLOR_WHITE ] = 0;
+    }
+
+    CachingEngine::~CachingEngine()
+    {
+    }
+
+    void CachingEngine::ClearBoard()
+    {
+        mEngine.ClearBoard();
+        mEngine.SetRandomSeed( mSeed );
+
+        mBoard.Clear();
+        mCaptures[ go::COLOR_BLACK ] = 0;
+        mCaptures[ go::COLOR_WHITE ] = 0;
+        mSynced = true;
+    }
+
+    bool CachingEngine::Play( go::Color color, go::Move move )
+    {
+        if ( !mEngine.Play( color, move ) )
+        {
+            return false;
+        }
+
+        Mirror( color, move );
+        return true;
+    }
+
+    go::Move CachingEngine::Genmove( go::Color color )
+    {
+        uint64_t key = 0;
+        if ( mSynced )
+        {
+            key = GetKey( color );
+
+            // A key collision could hand out a move illegal here
+            go::Move move;
+            if ( mCache.Find( key, move ) && mBoard.IsLegal( color, move ) && mEngine.Play( color, move ) )
+            {
+                CMN_PROFILE_COUNT( "reply_cache.hits", 1 );
+                Mirror( color, move );
+                return move;
+            }
+        }
+
+        go::Move move = mEngine.Genmove( color );
+        if ( mSynced )
+        {
+            CMN_PROFILE_COUNT( "reply_cache.misses", 1 );
+            mCache.Insert( key, move );
+        }
+        Mirror( color, move );
+        return move;
+    }
+
+    void CachingEngine::ListStones( std::list< go::Stone > & stones, go::Color color )
+    {
+        mEngine.ListStones( stones, color );
+    }
+
+    void CachingEngine::UpdateBoard( go::Board & board )
+    {
+        mEngine.UpdateBoard( board );
+    }
+
+    float CachingEngine::GetScore( go::Color color )
+    {
+        return mEngine.GetScore( color );
+    }
+
+    void CachingEngine::SetRandomSeed( unsigned seed )
+    {
+        mSeed = seed;
+        mEngine.SetRandomSeed( seed );
+    }
+
+    uint64_t CachingEngine::GetKey( go::Color color ) const
+    {
+        return ReplyCache::GetKey( mBoard.GetHash( color ),
+            mCaptures[ go::COLOR_BLACK ], mCaptures[ go::COLOR_WHITE ], mLevel, mSeed );
+    }
+
+    void CachingEngine::Mirror( go::Color color, go::Move move )
+    {
+        if ( !mSynced )
+        {
+            return;
+        }
+
+        unsigned stonesBefore = CountStones();
+        if ( !mBoard.Play( color, move ) )
+        {
+            mSynced = false;
+            return;
+        }
+
+        if ( move.type == go::MOVE_TYPE_PLACE )
+        {
+            mCaptures[ color ] += stonesBefore + 1 - CountStones();
+        }
+    }
+
+    unsigned CachingEngine::CountStones() const
+    {
+        unsigned count = 0;
+        for ( unsigned row = 0; row < mBoardSize; ++ row )
+        {
+            for ( unsigned column = 0; column < mBoardSize; ++ column )
+            {
+                if ( mBoard( row, column ) != go::CELL_EMPTY )
+                {
+                    count ++;
+                }
+            }
+        }
+        return count;
+    }
+
+} // namespace gnugo
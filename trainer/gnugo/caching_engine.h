@@ -0,0 +1,73 @@
+#ifndef __GNUGO_CACHING_ENGINE_H__
+#define __GNUGO_CACHING_ENGINE_H__
+
+#include "gnugo/engine.h"
+#include "go/board.h"
+
+namespace gnugo {
+
+    class ReplyCache;
+
+    // Engine answering Genmove() from a reply cache when it can. With the
+    // random seed reset at every new game, GNU Go's move is a function of
+    // the position, so a position met before gets the stored reply, which
+    // is only played on the engine instead of generated. The position is
+    // mirrored on a board of its own to compute the cache key.
+    //
+    // Everything else goes to the wrapped engine. A move the board refuses
+    // but the engine takes puts the cache aside until the next game.
+
+    class CachingEngine : public Engine
+    {
+    public:
+        void
+        ClearBoard();
+
+        bool
+        Play( go::Color, go::Move );
+
+        go::Move
+        Genmove( go::Color );
+
+        using Engine::ListStones;
+
+        void
+        ListStones( std::list< go::Stone > &, go::Color );
+
+        void
+        UpdateBoard( go::Board & );
+
+        float
+        GetScore( go::Color );
+
+        void
+        SetRandomSeed( unsigned );
+
+    public:
+        CachingEngine( Engine &, ReplyCache &, unsigned seed );
+        ~CachingEngine();
+
+    private:
+        uint64_t
+        GetKey( go::Color ) const;
+
+        // Follows a move the engine has played
+        void
+        Mirror( go::Color, go::Move );
+
+        unsigned
+        CountStones() const;
+
+    private:
+        Engine &        mEngine;
+        ReplyCache &    mCache;
+        unsigned        mSeed;
+
+        go::Board       mBoard;
+        unsigned        mCaptures[2];   // stones captured by each colour
+        bool            mSynced;
+    };
+
+} // namespace gnugo
+
+#endif // __GNUGO_CACHING_ENGINE_H__
@@ -4,56 +4,51 @@
 #include "go/player.h"
 #include "go/stone.h"
 #include <list>
-#include <string>
-#include <windows.h>
 
 namespace gnugo {
 
     class Engine
     {
     public:
-        std::string
-        Execute( std::string command );
+        virtual void
+        ClearBoard() = 0;
 
-        void
-        ClearBoard();
-
-        bool
-        Play( go::Color, go::Move );
+        virtual bool
+        Play( go::Color, go::Move ) = 0;
 
-        go::Move
-        Genmove( go::Color );
+        virtual go::Move
+        Genmove( go::Color ) = 0;
 
-        void
-        ListStones( std::list< go::Stone > &, go::Color );
+        virtual void
+        ListStones( std::list< go::Stone > &, go::Color ) = 0;
 
         void
         ListStones( std::list< go::Stone > & );
 
-        void
+        virtual void
         UpdateBoard( go::Board & );
 
-        void
-        ShowBoard( go::Board & );
-
         unsigned
         GetBoardSize() const { return mBoardSize; }
 
-        float
-        GetScore( go::Color );
+        virtual float
+        GetScore( go::Color ) = 0;
+
+        // Makes move generation start from this seed again; it advances
+        // with every new game otherwise
+        virtual void
+        SetRandomSeed( unsigned ) = 0;
+
+        unsigned
+        GetLevel() const { return mLevel; }
 
     public:
-        Engine( unsigned level, unsigned boardSize, unsigned seed = 0 );
-        ~Engine();
+        Engine( unsigned level, unsigned boardSize );
+        virtual ~Engine();
 
-    private:
+    protected:
         unsigned    mLevel;
         unsigned    mBoardSize;
-
-        HANDLE      mStdoutRead;
-        HANDLE      mStdoutWrite;
-        HANDLE      mStdinRead;
-        HANDLE      mStdinWrite;
     };
 
 } // namespace gnugo
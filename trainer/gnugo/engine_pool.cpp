@@ -0,0 +1,102 @@
+#include "cmn/trace.h"
+#include "gnugo/engine_pool.h"
+#include "gnugo/exceptions.h"
+
+namespace gnugo {
+
+    EnginePool::EnginePool()
+    {
+    }
+
+    EnginePool::~EnginePool()
+    {
+        Clear();
+    }
+
+    std::shared_ptr< GtpEngine > EnginePool::Acquire( unsigned level, unsigned boardSize )
+    {
+        GtpEngine * engine = nullptr;
+
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            std::vector< GtpEngine * > & idle = mIdle[ Key( level, boardSize ) ];
+            if ( !idle.empty() )
+            {
+                engine = idle.back();
+                idle.pop_back();
+            }
+        }
+
+        // Spawning takes a while, don't hold the lock
+        if ( engine == nullptr )
+        {
+            engine = new GtpEngine( level, boardSize );
+        }
+
+        return std::shared_ptr< GtpEngine >( engine,
+            [ this, level, boardSize ] ( GtpEngine * released ) {
+                Release( released, level, boardSize );
+            } );
+    }
+
+    void EnginePool::Release( GtpEngine * engine, unsigned level, unsigned boardSize )
+    {
+        // Reset outside of the lock; an engine that died during the game or
+        // the reset is dropped and will be respawned on demand
+        if ( !engine->IsAlive() )
+        {
+            delete engine;
+            return;
+        }
+
+        try
+        {
+            engine->ClearBoard();
+        }
+        catch ( const EngineFailure & )
+        {
+            delete engine;
+            return;
+        }
+
+        if ( !engine->IsAlive() )
+        {
+            delete engine;
+            return;
+        }
+
+        std::lock_guard< std::mutex > lock( mMutex );
+        mIdle[ Key( level, boardSize ) ].push_back( engine );
+    }
+
+    size_t EnginePool::GetIdleCount() const
+    {
+        std::lock_guard< std::mutex > lock( mMutex );
+
+        size_t count = 0;
+        for ( auto & idle : mIdle )
+        {
+            count += idle.second.size();
+        }
+        return count;
+    }
+
+    void EnginePool::Clear()
+    {
+        std::map< Key, std::vector< GtpEngine * > > idle;
+
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            idle.swap( mIdle );
+        }
+
+        for ( auto & engines : idle )
+        {
+            for ( GtpEngine * engine : engines.second )
+            {
+                delete engine;
+            }
+        }
+    }
+
+} // namespace gnugo
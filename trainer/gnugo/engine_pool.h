@@ -0,0 +1,48 @@
+#ifndef __GNUGO_ENGINE_POOL_H__
+#define __GNUGO_ENGINE_POOL_H__
+
+#include "gnugo/gtp_engine.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace gnugo {
+
+    // Keeps GNU Go processes alive between games. Acquire() hands out an
+    // idle engine of the requested level and board size, or spawns a new
+    // one; when the last reference is dropped the engine gets its board
+    // cleared and goes back to the pool, unless its process has died.
+    // The pool must outlive the engines it handed out.
+
+    class EnginePool
+    {
+    public:
+        std::shared_ptr< GtpEngine >
+        Acquire( unsigned level, unsigned boardSize );
+
+        size_t
+        GetIdleCount() const;
+
+        void
+        Clear();
+
+    public:
+        EnginePool();
+        ~EnginePool();
+
+    private:
+        void
+        Release( GtpEngine *, unsigned level, unsigned boardSize );
+
+    private:
+        typedef std::pair< unsigned, unsigned > Key;
+
+        mutable std::mutex                              mMutex;
+        std::map< Key, std::vector< GtpEngine * > >     mIdle;
+    };
+
+} // namespace gnugo
+
+#endif // __GNUGO_ENGINE_POOL_H__
@@ -0,0 +1,22 @@
+#ifndef __GNUGO_EXCEPTIONS_H__
+#define __GNUGO_EXCEPTIONS_H__
+
+#include "cmn/platform.h"
+
+#include <cstdio>
+#include <exception>
+#include <string>
+
+// EngineFailure: the engine process is gone, a command couldn't be sent
+// or its response never came
+
+#define EXCEPTION_NAMESPACE gnugo
+#define EXCEPTION_CODES \
+    C( EngineFailure, "%s" )
+
+#include "cmn/exception.inl"
+
+#undef EXCEPTION_CODES
+#undef EXCEPTION_NAMESPACE
+
+#endif // __GNUGO_EXCEPTIONS_H__
@@ -1,3 +1,4 @@
+#include "cmn/trace.h"
 #include "gnugo/engine.h"
 #include "gnugo/game.h"
 #include "gnugo/player_base.h"
@@ -17,11 +18,20 @@ namespace gnugo {
     void Game::Init()
     {
         mEngine.ClearBoard();
+        mBoard.Clear();
     }
 
     void Game::UpdateBoard( go::Color lastPlayer, go::Move lastMove )
     {
-        mEngine.UpdateBoard( mBoard );
+        // The engine has already accepted the move; replaying it on the
+        // board resolves the captures without asking the engine for the
+        // whole position. Should the board refuse it, the two disagree,
+        // and the board is rebuilt from the engine's stones.
+        if ( !mBoard.Play( lastPlayer, lastMove ) )
+        {
+            CMN_MSG( "Board out of sync with the engine, listing its stones" );
+            mEngine.UpdateBoard( mBoard );
+        }
     }
 
 } // namespace gnugo
@@ -0,0 +1,424 @@
+#include "cmn/profile.h"
+#include "cmn/trace.h"
+#include "gnugo/exceptions.h"
+#include "gnugo/gtp_engine.h"
+#include "go/board.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if CMN_POSIX
+    #include <cerrno>
+    #include <csignal>
+    #include <fcntl.h>
+    #include <mutex>
+    #include <spawn.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+
+    extern char ** environ;
+#endif
+
+namespace gnugo {
+
+    inline static const char * ColorToString( go::Color color )
+    {
+        switch ( color )
+        {
+        case go::COLOR_BLACK:
+            return "black";
+        case go::COLOR_WHITE:
+            return "white";
+        default:
+            CMN_FAIL();
+            return nullptr;
+        }
+    }
+
+    inline static std::string CoordToString( unsigned row, unsigned column )
+    {
+        char rowChar = row + 'A';
+        std::string retval;
+        retval.push_back( ( rowChar >= 'I' ) ? ( rowChar + 1 ) : rowChar );
+        retval += std::to_string( column + 1 );
+        return retval;
+    }
+
+    inline static void StringToCoord( const char * str, unsigned & row, unsigned & column )
+    {
+        char rowChar = str[0];
+        row     = ( rowChar > 'I' ) ? ( rowChar - 'A' - 1 ) : ( rowChar - 'A' );
+        column  = std::atoi( str + 1 ) - 1;
+    }
+
+    static const size_t kReadChunkSize = 4096;
+
+    inline static std::vector< std::string > CommandLineArgs(
+        unsigned level, unsigned boardSize, unsigned seed )
+    {
+        std::vector< std::string > args;
+        args.push_back( GNUGO_EXE );
+        args.push_back( "--mode" );
+        args.push_back( "gtp" );
+        args.push_back( "--level" );
+        args.push_back( std::to_string( level ) );
+        args.push_back( "--boardsize" );
+        args.push_back( std::to_string( boardSize ) );
+        if ( seed )
+        {
+            args.push_back( "--seed" );
+            args.push_back( std::to_string( seed ) );
+        }
+        args.push_back( "--never-resign" );
+        return args;
+    }
+
+#if CMN_WIN32
+
+    GtpEngine::GtpEngine( unsigned level, unsigned boardSize, unsigned seed /* = 0 */ )
+        : Engine( level, boardSize )
+        , mProcess( nullptr )
+        , mStdoutRead( nullptr )
+        , mStdoutWrite( nullptr )
+        , mStdinRead( nullptr )
+        , mStdinWrite( nullptr )
+    {
+        SECURITY_ATTRIBUTES securityAttributes;
+        ZeroMemory( &securityAttributes, sizeof( SECURITY_ATTRIBUTES ) );
+        securityAttributes.nLength          = sizeof( SECURITY_ATTRIBUTES );
+        securityAttributes.bInheritHandle   = TRUE;
+
+        BOOL success = FALSE;
+        success = CreatePipe( &mStdoutRead, &mStdoutWrite, &securityAttributes, 0 );
+        CMN_ASSERT( success != FALSE );
+        success = SetHandleInformation( mStdoutRead, HANDLE_FLAG_INHERIT, 0 );
+        CMN_ASSERT( success != FALSE );
+
+        success = CreatePipe( &mStdinRead, &mStdinWrite, &securityAttributes, 0 );
+        CMN_ASSERT( success != FALSE );
+        success = SetHandleInformation( mStdinWrite, HANDLE_FLAG_INHERIT, 0 );
+        CMN_ASSERT( success != FALSE );
+
+        PROCESS_INFORMATION processInformation;
+        ZeroMemory( &processInformation, sizeof( PROCESS_INFORMATION ) );
+
+        STARTUPINFO startupInfo;
+        ZeroMemory( &startupInfo, sizeof( STARTUPINFO ) );
+        startupInfo.cb          = sizeof( STARTUPINFO );
+        startupInfo.hStdError   = mStdoutWrite;
+        startupInfo.hStdOutput  = mStdoutWrite;
+        startupInfo.hStdInput   = mStdinRead;
+        startupInfo.dwFlags     = STARTF_USESTDHANDLES;
+
+        std::string cmdLine;
+        for ( auto & arg : CommandLineArgs( mLevel, mBoardSize, seed ) )
+        {
+            if ( !cmdLine.empty() )
+            {
+                cmdLine += ' ';
+            }
+            cmdLine += arg;
+        }
+
+        success = CreateProcess( NULL, const_cast< char * >( cmdLine.data() ), NULL, NULL,
+            TRUE, 0, NULL, NULL, &startupInfo, &processInformation );
+        CMN_ASSERT( success != FALSE );
+
+        mProcess = processInformation.hProcess;
+        success = CloseHandle( processInformation.hThread );
+        CMN_ASSERT( success != FALSE );
+    }
+
+    GtpEngine::~GtpEngine()
+    {
+        BOOL success = FALSE;
+        success = CloseHandle( mProcess );
+        CMN_ASSERT( success );
+        success = CloseHandle( mStdoutRead );
+        CMN_ASSERT( success );
+        success = CloseHandle( mStdoutWrite );
+        CMN_ASSERT( success );
+        success = CloseHandle( mStdinRead );
+        CMN_ASSERT( success );
+        success = CloseHandle( mStdinWrite );
+        CMN_ASSERT( success );
+    }
+
+    bool GtpEngine::IsAlive()
+    {
+        return WaitForSingleObject( mProcess, 0 ) == WAIT_TIMEOUT;
+    }
+
+    void GtpEngine::Write( const char * data, size_t size )
+    {
+        DWORD writtenBytes = 0;
+        BOOL success = WriteFile( mStdinWrite, data, size, &writtenBytes, 0 );
+        if ( success == FALSE || writtenBytes != size )
+        {
+            throw EngineFailure( "can't write to the engine" );
+        }
+    }
+
+    size_t GtpEngine::Read( char * data, size_t size )
+    {
+        DWORD readBytes = 0;
+        BOOL success = ReadFile( mStdoutRead, data, size, &readBytes, 0 );
+        return ( success != FALSE ) ? readBytes : 0;
+    }
+
+#elif CMN_POSIX
+
+    static std::once_flag sIgnoreSigpipeFlag;
+
+    GtpEngine::GtpEngine( unsigned level, unsigned boardSize, unsigned seed /* = 0 */ )
+        : Engine( level, boardSize )
+        , mProcess( -1 )
+        , mStdoutRead( -1 )
+        , mStdinWrite( -1 )
+    {
+        int result = 0; CMN_UNUSED( result );
+
+        // A dead engine makes write() fail with EPIPE instead
+        std::call_once( sIgnoreSigpipeFlag, [] { signal( SIGPIPE, SIG_IGN ); } );
+
+        // Close on exec from the start, so that no end leaks into an
+        // engine another thread spawns meanwhile and keeps a pipe open.
+        // The child's dup2 copies don't inherit the flag.
+        int stdoutPipe[2];
+        result = pipe2( stdoutPipe, O_CLOEXEC );
+        CMN_ASSERT( result == 0 );
+
+        int stdinPipe[2];
+        result = pipe2( stdinPipe, O_CLOEXEC );
+        CMN_ASSERT( result == 0 );
+
+        posix_spawn_file_actions_t fileActions;
+        posix_spawn_file_actions_init( &fileActions );
+        posix_spawn_file_actions_adddup2( &fileActions, stdinPipe[0], STDIN_FILENO );
+        posix_spawn_file_actions_adddup2( &fileActions, stdoutPipe[1], STDOUT_FILENO );
+
+        std::vector< std::string > args = CommandLineArgs( mLevel, mBoardSize, seed );
+        std::vector< char * > argv;
+        for ( auto & arg : args )
+        {
+            argv.push_back( const_cast< char * >( arg.c_str() ) );
+        }
+        argv.push_back( nullptr );
+
+        result = posix_spawn( &mProcess, argv[0], &fileActions, nullptr, argv.data(), environ );
+        CMN_ASSERT( result == 0 );
+
+        posix_spawn_file_actions_destroy( &fileActions );
+
+        close( stdoutPipe[1] );
+        close( stdinPipe[0] );
+
+        mStdoutRead = stdoutPipe[0];
+        mStdinWrite = stdinPipe[1];
+
+        mReadBuffer.reserve( kReadChunkSize );
+    }
+
+    GtpEngine::~GtpEngine()
+    {
+        // Closing stdin makes the engine quit on EOF
+        close( mStdinWrite );
+        close( mStdoutRead );
+
+        if ( mProcess > 0 )
+        {
+            int status = 0;
+            while ( waitpid( mProcess, &status, 0 ) < 0 && errno == EINTR );
+        }
+    }
+
+    bool GtpEngine::IsAlive()
+    {
+        if ( mProcess > 0 )
+        {
+            int status = 0;
+            if ( waitpid( mProcess, &status, WNOHANG ) == mProcess )
+            {
+                // Reaped, don't wait for it again on destruction
+                mProcess = -1;
+            }
+        }
+        return mProcess > 0;
+    }
+
+    void GtpEngine::Write( const char * data, size_t size )
+    {
+        while ( size > 0 )
+        {
+            ssize_t writtenBytes = write( mStdinWrite, data, size );
+            if ( writtenBytes < 0 && errno == EINTR )
+            {
+                continue;
+            }
+            if ( writtenBytes <= 0 )
+            {
+                throw EngineFailure( std::strerror( errno ) );
+            }
+
+            data += writtenBytes;
+            size -= writtenBytes;
+        }
+    }
+
+    size_t GtpEngine::Read( char * data, size_t size )
+    {
+        ssize_t readBytes = 0;
+        do {
+            readBytes = read( mStdoutRead, data, size );
+        } while ( readBytes < 0 && errno == EINTR );
+        return ( readBytes > 0 ) ? readBytes : 0;
+    }
+
+#endif // CMN_POSIX
+
+    std::string GtpEngine::Execute( std::string command )
+    {
+        CMN_PROFILE_SCOPE( "gtp.execute" );
+
+        command += '\n';
+        Write( command.data(), command.size() );
+
+        // Every GTP response is terminated by an empty line. Pull large
+        // chunks until the terminator shows up, so that a typical response
+        // takes a single read.
+        size_t scanned = 0;
+        size_t terminator = std::string::npos;
+        while ( ( terminator = mReadBuffer.find( "\n\n", scanned ) ) == std::string::npos )
+        {
+            scanned = mReadBuffer.empty() ? 0 : ( mReadBuffer.size() - 1 );
+
+            char chunk[ kReadChunkSize ];
+            size_t readBytes = Read( chunk, kReadChunkSize );
+            if ( readBytes == 0 )
+            {
+                // End of file or error, the engine is gone
+                mReadBuffer.clear();
+                throw EngineFailure( "no response from the engine" );
+            }
+
+            for ( size_t i = 0; i < readBytes; ++ i )
+            {
+                if ( chunk[i] != '\r' )
+                {
+                    mReadBuffer.push_back( chunk[i] );
+                }
+            }
+        }
+
+        std::string response;
+        size_t frameEnd = ( terminator != std::string::npos ) ? terminator : mReadBuffer.size();
+        response.reserve( frameEnd );
+        for ( size_t i = 0; i < frameEnd; ++ i )
+        {
+            if ( mReadBuffer[i] != '\n' )
+            {
+                response.push_back( mReadBuffer[i] );
+            }
+        }
+
+        size_t consumed = ( terminator != std::string::npos ) ? ( terminator + 2 ) : frameEnd;
+        mReadBuffer.erase( 0, consumed );
+
+        return response;
+    }
+
+    void GtpEngine::ClearBoard()
+    {
+        std::string response = Execute( "clear_board" );
+        CMN_ASSERT( response[0] == '=' );
+    }
+
+    bool GtpEngine::Play( go::Color color, go::Move move )
+    {
+        std::string command =
+            std::string( "play " ) +
+            ColorToString( color ) +
+            std::string( " " );
+
+        switch ( move.type )
+        {
+        case go::MOVE_TYPE_PLACE:
+            command += CoordToString( move.row, move.column );
+            break;
+        case go::MOVE_TYPE_PASS:
+            command += "pass";
+            break;
+        default:
+            CMN_FAIL();
+        }
+
+        std::string response = Execute( command );
+        return response[0] == '=';
+    }
+
+    go::Move GtpEngine::Genmove( go::Color color )
+    {
+        std::string command =
+            std::string( "genmove " ) +
+            ColorToString( color );
+
+        std::string response = Execute( command );
+        CMN_ASSERT( response[0] == '=' );
+
+        go::Move retval;
+
+        if ( std::string( "PASS" ) == ( response.data() + 2 ) )
+        {
+            retval.type = go::MOVE_TYPE_PASS;
+        }
+        else
+        {
+            retval.type = go::MOVE_TYPE_PLACE;
+            StringToCoord( response.data() + 2, retval.row, retval.column );
+        }
+
+        return retval;
+    }
+
+    void GtpEngine::ListStones( std::list< go::Stone > & stones, go::Color color )
+    {
+        std::string command =
+            std::string( "list_stones " ) +
+            ColorToString( color );
+
+        std::string response = Execute( command );
+        CMN_ASSERT( response[0] == '=' );
+
+        char * token = std::strtok( const_cast< char * >( response.data() + 2 ), " " );
+        while ( token != NULL )
+        {
+            go::Stone stone;
+            stone.color = color;
+            StringToCoord( token, stone.row, stone.column );
+            stones.push_back( stone );
+
+            token = std::strtok( NULL, " " );
+        }
+    }
+
+    float GtpEngine::GetScore( go::Color color )
+    {
+        std::string response = Execute( "final_score" );
+        CMN_ASSERT( response[0] == '=' );
+
+        float score = std::atof( response.c_str() + 4 );
+        if ( ( response[2] == 'W' && color == go::COLOR_WHITE ) ||
+             ( response[2] == 'B' && color == go::COLOR_BLACK ) )
+            return score;
+        else
+            return -score;
+    }
+
+    void GtpEngine::SetRandomSeed( unsigned seed )
+    {
+        std::string response = Execute( "set_random_seed " + std::to_string( seed ) );
+        CMN_ASSERT( response[0] == '=' );
+    }
+
+} // namespace gnugo
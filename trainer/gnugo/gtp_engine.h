@@ -0,0 +1,82 @@
+#ifndef __GNUGO_GTP_ENGINE_H__
+#define __GNUGO_GTP_ENGINE_H__
+
+#include "cmn/platform.h"
+#include "gnugo/engine.h"
+#include <string>
+
+#if CMN_WIN32
+    #include <windows.h>
+#elif CMN_POSIX
+    #include <sys/types.h>
+#endif
+
+namespace gnugo {
+
+    // Runs GNUGO_EXE in a child process and talks GTP to it over pipes.
+    // Commands throw EngineFailure once the process is gone. On POSIX the
+    // first engine makes the process ignore SIGPIPE, so that writing to a
+    // dead engine fails instead of killing the trainer.
+
+    class GtpEngine : public Engine
+    {
+    public:
+        std::string
+        Execute( std::string command );
+
+        void
+        ClearBoard();
+
+        bool
+        Play( go::Color, go::Move );
+
+        go::Move
+        Genmove( go::Color );
+
+        using Engine::ListStones;
+
+        void
+        ListStones( std::list< go::Stone > &, go::Color );
+
+        float
+        GetScore( go::Color );
+
+        void
+        SetRandomSeed( unsigned );
+
+        bool
+        IsAlive();
+
+    public:
+        GtpEngine( unsigned level, unsigned boardSize, unsigned seed = 0 );
+        ~GtpEngine();
+
+    private:
+        void
+        Write( const char * data, size_t size );
+
+        size_t
+        Read( char * data, size_t size );
+
+    private:
+        // Responses are read in large chunks and framed at the empty line
+        // terminating every GTP response; the tail of the last chunk is
+        // kept for the next command.
+        std::string mReadBuffer;
+
+    #if CMN_WIN32
+        HANDLE      mProcess;
+        HANDLE      mStdoutRead;
+        HANDLE      mStdoutWrite;
+        HANDLE      mStdinRead;
+        HANDLE      mStdinWrite;
+    #elif CMN_POSIX
+        pid_t       mProcess;
+        int         mStdoutRead;
+        int         mStdinWrite;
+    #endif
+    };
+
+} // namespace gnugo
+
+#endif // __GNUGO_GTP_ENGINE_H__
@@ -0,0 +1,273 @@
+#include "cmn/trace.h"
+#include "gnugo/native_engine.h"
+#include "go/board.h"
+
+#include <ctime>
+#include <mutex>
+#include <stdexcept>
+
+extern "C" {
+    #include "liberty.h"
+    #include "clock.h"
+    #include "gg_utils.h"
+}
+
+namespace gnugo {
+
+    static std::once_flag   sPatternsInitFlag;
+    static std::mutex       sPatternsMutex;
+    static unsigned         sPatternsBoardSize = 0;
+
+    static thread_local bool sContextInitialized = false;
+    static thread_local bool sContextInUse = false;
+
+    inline static int ColorToNative( go::Color color )
+    {
+        switch ( color )
+        {
+        case go::COLOR_BLACK:
+            return BLACK;
+        case go::COLOR_WHITE:
+            return WHITE;
+        default:
+            CMN_FAIL();
+            return EMPTY;
+        }
+    }
+
+    // Keep the orientation used by the GTP engine: the trainer's row is the
+    // GTP column letter and the trainer's column is the GTP row number.
+
+    inline static int CoordToNative( unsigned row, unsigned column, unsigned boardSize )
+    {
+        return POS( boardSize - 1 - column, row );
+    }
+
+    inline static void NativeToCoord( int pos, unsigned boardSize, unsigned & row, unsigned & column )
+    {
+        row     = J( pos );
+        column  = boardSize - 1 - I( pos );
+    }
+
+    NativeEngine::NativeEngine( unsigned level, unsigned boardSize, unsigned seed /* = 0 */ )
+        : Engine( level, boardSize )
+        , mThread( std::this_thread::get_id() )
+    {
+        // The shared pattern databases are adapted to one board size
+        {
+            std::lock_guard< std::mutex > lock( sPatternsMutex );
+            if ( sPatternsBoardSize != 0 && sPatternsBoardSize != mBoardSize )
+            {
+                CMN_ERR( "Native engines can't mix board sizes %u and %u", sPatternsBoardSize, mBoardSize );
+                CMN_THROW( std::invalid_argument( "NativeEngine board size" ) );
+            }
+            sPatternsBoardSize = mBoardSize;
+        }
+
+        CMN_ASSERT( !sContextInUse );
+        sContextInUse = true;
+
+        unsigned randomSeed = seed ? seed : static_cast< unsigned >( std::time( nullptr ) );
+
+        std::call_once( sPatternsInitFlag, init_gnugo_patterns );
+
+        if ( !sContextInitialized )
+        {
+            init_gnugo_context( static_cast< float >( DEFAULT_MEMORY ), randomSeed );
+            sContextInitialized = true;
+        }
+
+        set_random_seed( randomSeed );
+        set_level( mLevel );
+        resign_allowed = 0;
+
+        gnugo_clear_board( mBoardSize );
+
+        // Adapt the shared pattern databases to the board size before this
+        // thread starts matching against them
+        {
+            std::lock_guard< std::mutex > lock( sPatternsMutex );
+            fixup_pattern_databases_for_board_size();
+        }
+    }
+
+    NativeEngine::~NativeEngine()
+    {
+        CMN_ASSERT( mThread == std::this_thread::get_id() );
+        sContextInUse = false;
+    }
+
+    void NativeEngine::ClearBoard()
+    {
+        CMN_ASSERT( mThread == std::this_thread::get_id() );
+
+        // A new game on a non-empty board gets a new random seed, the same
+        // way the GTP clear_board command does it
+        if ( stones_on_board( BLACK | WHITE ) > 0 )
+        {
+            update_random_seed();
+        }
+
+        gnugo_clear_board( mBoardSize );
+    }
+
+    bool NativeEngine::Play( go::Color color, go::Move move )
+    {
+        CMN_ASSERT( mThread == std::this_thread::get_id() );
+
+        int pos = PASS_MOVE;
+
+        switch ( move.type )
+        {
+        case go::MOVE_TYPE_PLACE:
+            if ( move.row >= mBoardSize || move.column >= mBoardSize )
+            {
+                return false;
+            }
+            pos = CoordToNative( move.row, move.column, mBoardSize );
+            break;
+        case go::MOVE_TYPE_PASS:
+            break;
+        default:
+            CMN_FAIL();
+        }
+
+        int nativeColor = ColorToNative( color );
+        if ( !is_allowed_move( pos, nativeColor ) )
+        {
+            return false;
+        }
+
+        gnugo_play_move( pos, nativeColor );
+        return true;
+    }
+
+    go::Move NativeEngine::Genmove( go::Color color )
+    {
+        CMN_ASSERT( mThread == std::this_thread::get_id() );
+        CMN_ASSERT( stackp == 0 );
+
+        int nativeColor = ColorToNative( color );
+        adjust_level_offset( nativeColor );
+
+        int resign = 0;
+        int pos = genmove( nativeColor, nullptr, &resign );
+        CMN_ASSERT( !resign );
+
+        gnugo_play_move( pos, nativeColor );
+
+        go::Move retval;
+        if ( pos == PASS_MOVE )
+        {
+            retval.type = go::MOVE_TYPE_PASS;
+        }
+        else
+        {
+            retval.type = go::MOVE_TYPE_PLACE;
+            NativeToCoord( pos, mBoardSize, retval.row, retval.column );
+        }
+
+        return retval;
+    }
+
+    void NativeEngine::ListStones( std::list< go::Stone > & stones, go::Color color )
+    {
+        CMN_ASSERT( mThread == std::this_thread::get_id() );
+
+        int nativeColor = ColorToNative( color );
+
+        for ( int i = 0; i < static_cast< int >( mBoardSize ); ++ i )
+        {
+            for ( int j = 0; j < static_cast< int >( mBoardSize ); ++ j )
+            {
+                if ( BOARD( i, j ) == nativeColor )
+                {
+                    go::Stone stone;
+                    stone.color = color;
+                    NativeToCoord( POS( i, j ), mBoardSize, stone.row, stone.column );
+                    stones.push_back( stone );
+                }
+            }
+        }
+    }
+
+    void NativeEngine::UpdateBoard( go::Board & goBoard )
+    {
+        CMN_ASSERT( mThread == std::this_thread::get_id() );
+
+        // Not called "board": the engine's BOARD() macro reads the global
+        // of that name
+        for ( int i = 0; i < static_cast< int >( mBoardSize ); ++ i )
+        {
+            for ( int j = 0; j < static_cast< int >( mBoardSize ); ++ j )
+            {
+                unsigned row, column;
+                NativeToCoord( POS( i, j ), mBoardSize, row, column );
+
+                switch ( BOARD( i, j ) )
+                {
+                case BLACK:
+                    goBoard.Set( row, column, go::CELL_BLACK );
+                    break;
+                case WHITE:
+                    goBoard.Set( row, column, go::CELL_WHITE );
+                    break;
+                default:
+                    goBoard.Set( row, column, go::CELL_EMPTY );
+                }
+            }
+        }
+    }
+
+    float NativeEngine::GetScore( go::Color color )
+    {
+        CMN_ASSERT( mThread == std::this_thread::get_id() );
+
+        // Same procedure as the GTP final_score command: finish the game
+        // with conservative moves from a fixed seed, score it and take the
+        // moves back.
+
+        unsigned savedRandomSeed = get_random_seed();
+        set_random_seed( 0 );
+
+        doing_scoring = 1;
+        struct board_state savedBoard;
+        store_board( &savedBoard );
+
+        int next = ( get_last_player() == EMPTY ) ? BLACK : OTHER_COLOR( get_last_player() );
+        int passes = 0;
+        int moves = 0;
+        int maxMoves = mBoardSize * mBoardSize;
+        do {
+            int move = genmove_conservative( next, nullptr );
+            gnugo_play_move( move, next );
+            if ( move != PASS_MOVE )
+            {
+                passes = 0;
+                moves ++;
+            }
+            else
+            {
+                passes ++;
+            }
+            next = OTHER_COLOR( next );
+        } while ( passes < 2 && moves < maxMoves );
+
+        float score = aftermath_compute_score( next, nullptr );
+
+        restore_board( &savedBoard );
+        doing_scoring = 0;
+
+        set_random_seed( savedRandomSeed );
+
+        // Positive score means white wins
+        return ( color == go::COLOR_WHITE ) ? score : -score;
+    }
+
+    void NativeEngine::SetRandomSeed( unsigned seed )
+    {
+        CMN_ASSERT( mThread == std::this_thread::get_id() );
+        set_random_seed( seed );
+    }
+
+} // namespace gnugo
@@ -0,0 +1,53 @@
+#ifndef __GNUGO_NATIVE_ENGINE_H__
+#define __GNUGO_NATIVE_ENGINE_H__
+
+#include "gnugo/engine.h"
+#include <thread>
+
+namespace gnugo {
+
+    // Calls the GNU Go engine library linked into the trainer directly.
+    // The library keeps its state in thread local storage, so a
+    // NativeEngine owns the engine context of the thread that created it:
+    // it must be used on that thread only, and there can be one engine
+    // per thread at a time. Engines living on different threads share the
+    // pattern databases and must use the same board size: constructing
+    // an engine for another size throws std::invalid_argument.
+
+    class NativeEngine : public Engine
+    {
+    public:
+        void
+        ClearBoard();
+
+        bool
+        Play( go::Color, go::Move );
+
+        go::Move
+        Genmove( go::Color );
+
+        using Engine::ListStones;
+
+        void
+        ListStones( std::list< go::Stone > &, go::Color );
+
+        void
+        UpdateBoard( go::Board & );
+
+        float
+        GetScore( go::Color );
+
+        void
+        SetRandomSeed( unsigned );
+
+    public:
+        NativeEngine( unsigned level, unsigned boardSize, unsigned seed = 0 );
+        ~NativeEngine();
+
+    private:
+        std::thread::id     mThread;
+    };
+
+} // namespace gnugo
+
+#endif // __GNUGO_NATIVE_ENGINE_H__
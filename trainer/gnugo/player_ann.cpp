@@ -1,20 +1,25 @@
 #include "ann/network.h"
+#include "cmn/profile.h"
 #include "cmn/trace.h"
 #include "gnugo/engine.h"
 #include "gnugo/player_ann.h"
 #include "go/board.h"
+#include "go/symmetry.h"
 #include "go/utils.h"
+#include "training/inference_batcher.h"
 
-#include <algorithm>
+#include <stdexcept>
 
 namespace gnugo {
 
     using namespace ANN;
     using namespace go;
 
-    PlayerAnn::PlayerAnn( ConstINetworkIn network, Engine & engine )
+    PlayerAnn::PlayerAnn( ConstINetworkIn network, Engine & engine, training::InferenceBatcher * batcher /* = nullptr */ )
         : PlayerBase( engine )
         , mNetwork( network )
+        , mBatcher( batcher )
+        , mSymmetryAveraging( false )
     {
     }
 
@@ -31,77 +36,125 @@ namespace gnugo {
         CMN_ASSERT( mNetwork->GetOutputsCount() == ( cellCount + 1 ) );
 
         mInputs.resize( cellCount );
+
+        if ( mSymmetryAveraging )
+        {
+            mSymmetryPoints.resize( kSymmetryCount * cellCount );
+            for ( unsigned symmetry = 0; symmetry < kSymmetryCount; ++ symmetry )
+            {
+                for ( unsigned point = 0; point < cellCount; ++ point )
+                {
+                    mSymmetryPoints[ symmetry * cellCount + point ] = TransformPoint( symmetry, point, boardSize );
+                }
+            }
+        }
+    }
+
+    void PlayerAnn::SetSymmetryAveraging( bool enabled )
+    {
+        // Takes effect at the next Init()
+        mSymmetryAveraging = enabled;
+    }
+
+    void PlayerAnn::Evaluate( const Inputs & inputs, std::vector< double > & outputs )
+    {
+        if ( mBatcher )
+        {
+            mBatcher->Compute( inputs, outputs );
+            return;
+        }
+
+        unsigned rowCount = static_cast< unsigned >( inputs.size() / mNetwork->GetInputsCount() );
+        if ( rowCount == 1 )
+        {
+            outputs = mNetwork->Compute( inputs );
+            return;
+        }
+
+        outputs.resize( rowCount * mNetwork->GetOutputsCount() );
+        mNetwork->ComputeBatch( inputs, rowCount, outputs );
     }
 
     Move PlayerAnn::MakeMove( const Board & board )
     {
+        CMN_PROFILE_SCOPE( "player_ann.make_move" );
+
         unsigned boardSize = board.GetSize();
         unsigned cellCount = boardSize * boardSize;
 
         // Prepare network inputs
 
-            for ( unsigned row = 0; row < boardSize; ++ row )
+            EncodeBoard( board, mColor, mInputs );
+
+        // Run the network
+
+            if ( mSymmetryAveraging )
             {
-                unsigned offset = row * boardSize;
-                for ( unsigned column = 0; column < boardSize; ++ column )
+                CMN_ASSERT( mSymmetryPoints.size() == kSymmetryCount * cellCount );
+
+                // Every orientation of the board, one row each
+                mSymmetryInputs.resize( kSymmetryCount * cellCount );
+                for ( unsigned symmetry = 0; symmetry < kSymmetryCount; ++ symmetry )
                 {
-                    double & input = mInputs[ column + offset ];
-                    Cell cell = board( row, column );
-                    if ( cell == CELL_EMPTY )
-                    {
-                        input = 0.0;
-                    }
-                    else if ( cell == CellFromColor( mColor ) )
+                    const unsigned * points = &mSymmetryPoints[ symmetry * cellCount ];
+                    double * inputs = &mSymmetryInputs[ symmetry * cellCount ];
+                    for ( unsigned point = 0; point < cellCount; ++ point )
                     {
-                        input = 1.0;
+                        inputs[ points[ point ] ] = mInputs[ point ];
                     }
-                    else
+                }
+
+                Evaluate( mSymmetryInputs, mSymmetryOutputs );
+
+                // Rating of a move in an orientation is the rating of the
+                // move it maps to there
+                mOutputs.assign( cellCount + 1, 0.0 );
+                for ( unsigned symmetry = 0; symmetry < kSymmetryCount; ++ symmetry )
+                {
+                    const unsigned * points = &mSymmetryPoints[ symmetry * cellCount ];
+                    const double * outputs = &mSymmetryOutputs[ symmetry * ( cellCount + 1 ) ];
+                    for ( unsigned point = 0; point < cellCount; ++ point )
                     {
-                        input = -1.0;
+                        mOutputs[ point ] += outputs[ points[ point ] ];
                     }
+                    mOutputs[ cellCount ] += outputs[ cellCount ];
+                }
+                for ( double & output : mOutputs )
+                {
+                    output /= kSymmetryCount;
                 }
             }
+            else
+            {
+                Evaluate( mInputs, mOutputs );
+            }
+            const std::vector< double > & networkOutputs = mOutputs;
 
-        // Run the network
-
-            const std::vector< double > networkOutputs = mNetwork->Compute( mInputs );
+        // Pick the best legal move
 
-        // Parse network outputs
+            board.GetLegalMoves( mColor, mLegalMoves );
+            CMN_ASSERT( networkOutputs.size() == mLegalMoves.size() );
 
-            typedef std::pair< double, unsigned > ValueIndexPair;
-            std::vector< ValueIndexPair > valueIndices;
-            valueIndices.reserve( networkOutputs.size() );
-            for ( size_t index = 0, n = networkOutputs.size(); index < n; ++ index )
+            while ( true )
             {
-                valueIndices.push_back( std::make_pair( networkOutputs[ index ], index ) );
-            }
-            std::sort( valueIndices.begin(), valueIndices.end(),
-                [] ( const ValueIndexPair & lh, const ValueIndexPair & rh ) {
-                    return lh.first < rh.first; } );
+                unsigned best = FindBestMove( networkOutputs, mLegalMoves );
+                Move move = MoveFromIndex( best, boardSize );
 
-            for ( auto & vi : valueIndices )
-            {
-                Move move;
-                if ( vi.second == cellCount )
-                {
-                    move.type = MOVE_TYPE_PASS;
-                }
-                else
+                if ( mEngine.Play( mColor, move ) )
                 {
-                    move.type   = MOVE_TYPE_PLACE;
-                    move.row    = vi.second / boardSize;
-                    move.column = vi.second % boardSize;
+                    return move;
                 }
 
-                if ( mEngine.Play( mColor, move ) )
+                // A pass is always legal, so the engine is out of order
+                if ( best == cellCount )
                 {
-                    return move;
+                    CMN_ERR( "The engine rejected a pass" );
+                    CMN_THROW( std::runtime_error( "PlayerAnn pass rejected" ) );
                 }
-            }
 
-        Move move;
-        move.type = MOVE_TYPE_PASS;
-        return move;
+                // Only if the engine's rules disagree with the board's
+                mLegalMoves[ best ] = false;
+            }
     }
 
 } // namespace gnugo
@@ -6,8 +6,19 @@
 
 #include <vector>
 
+namespace training {
+    class InferenceBatcher;
+}
+
 namespace gnugo {
 
+    // Plays the legal move the network rates best. With a batcher the
+    // network is run through it, together with the other games using the
+    // same batcher. With symmetry averaging the network rates all 8
+    // orientations of the board in one batch, and the ratings of each
+    // move are averaged, so play doesn't depend on the orientation; a
+    // batcher then needs room for 8 rows.
+
     class PlayerAnn : public PlayerBase
     {
     public:
@@ -17,15 +28,31 @@ namespace gnugo {
         go::Move
         MakeMove( const go::Board & );
 
+        void
+        SetSymmetryAveraging( bool );
+
     public:
-        PlayerAnn( ANN::ConstINetworkIn, Engine & );
+        PlayerAnn( ANN::ConstINetworkIn, Engine &, training::InferenceBatcher * = nullptr );
         ~PlayerAnn();
 
     private:
         typedef std::vector< double > Inputs;
 
-        ANN::ConstINetworkRef   mNetwork;
-        Inputs                  mInputs;
+        // Outputs for one or more rows of inputs
+        void
+        Evaluate( const Inputs &, std::vector< double > & outputs );
+
+    private:
+        ANN::ConstINetworkRef           mNetwork;
+        training::InferenceBatcher *    mBatcher;
+        Inputs                          mInputs;
+        std::vector< double >           mOutputs;
+        std::vector< bool >             mLegalMoves;
+
+        bool                            mSymmetryAveraging;
+        std::vector< unsigned >         mSymmetryPoints;
+        Inputs                          mSymmetryInputs;
+        std::vector< double >           mSymmetryOutputs;
     };
 
 } // namespace gnugo
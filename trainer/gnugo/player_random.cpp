@@ -28,7 +28,7 @@ namespace gnugo {
             retval.type     = ( distType( mRandomEngine ) == 0 ) ? MOVE_TYPE_PLACE : MOVE_TYPE_PASS;
             retval.row      = distCoord( mRandomEngine );
             retval.column   = distCoord( mRandomEngine );
-        } while ( !mEngine.Play( mColor, retval ) );
+        } while ( !board.IsLegal( mColor, retval ) || !mEngine.Play( mColor, retval ) );
 
         return retval;
     }
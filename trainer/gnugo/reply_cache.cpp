@@ -0,0 +1,140 @@
+#include "gnugo/reply_cache.h"
+
+namespace gnugo {
+
+    // Picked by the top bits of the key
+    static const unsigned kShardCount = 64;
+
+    static uint64_t Mix( uint64_t value )
+    {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        value *= 0xC4CEB9FE1A85EC53ull;
+        value ^= value >> 33;
+        return value;
+    }
+
+    uint64_t ReplyCache::GetKey( uint64_t situation, unsigned blackCaptures, unsigned whiteCaptures,
+                                 unsigned level, unsigned seed )
+    {
+        uint64_t key = Mix( situation );
+        key = Mix( key ^ ( ( static_cast< uint64_t >( blackCaptures ) << 32 ) | whiteCaptures ) );
+        key = Mix( key ^ ( ( static_cast< uint64_t >( level ) << 32 ) | seed ) );
+        return key;
+    }
+
+    ReplyCache::ReplyCache( size_t capacity /* = 1 << 20 */ )
+        : mShardCapacity( ( capacity + kShardCount - 1 ) / kShardCount )
+    {
+        for ( unsigned i = 0; i < kShardCount; ++ i )
+        {
+            mShards.emplace_back( new Shard );
+        }
+    }
+
+    ReplyCache::~ReplyCache()
+    {
+    }
+
+    bool ReplyCache::Find( uint64_t key, go::Move & move )
+    {
+        Shard & shard = GetShard( key );
+        std::lock_guard< std::mutex > lock( shard.mutex );
+
+        auto found = shard.replies.find( key );
+        if ( found == shard.replies.end() )
+        {
+            return false;
+        }
+
+        move = found->second;
+        return true;
+    }
+
+    void ReplyCache::Insert( uint64_t key, go::Move move )
+    {
+        Shard & shard = GetShard( key );
+        std::lock_guard< std::mutex > lock( shard.mutex );
+
+        if ( shard.replies.size() < mShardCapacity )
+        {
+            shard.replies[ key ] = move;
+        }
+    }
+
+    size_t ReplyCache::GetSize() const
+    {
+        size_t size = 0;
+        for ( auto & shard : mShards )
+        {
+            std::lock_guard< std::mutex > lock( shard->mutex );
+            size += shard->replies.size();
+        }
+        return size;
+    }
+
+    // Saved as a count, then a key and a move per reply: 0xFFFFFFFF for a
+    // pass, row * 256 + column otherwise
+
+    static const uint32_t kPass = 0xFFFFFFFF;
+
+    void ReplyCache::Save( std::ostream & stream ) const
+    {
+        std::vector< std::pair< uint64_t, uint32_t > > replies;
+        for ( auto & shard : mShards )
+        {
+            std::lock_guard< std::mutex > lock( shard->mutex );
+            for ( auto & reply : shard->replies )
+            {
+                const go::Move & move = reply.second;
+                uint32_t encoded = ( move.type == go::MOVE_TYPE_PASS ) ? kPass : ( move.row << 8 ) | move.column;
+                replies.emplace_back( reply.first, encoded );
+            }
+        }
+
+        uint64_t count = replies.size();
+        stream.write( reinterpret_cast< const char * >( &count ), sizeof( count ) );
+        for ( auto & reply : replies )
+        {
+            stream.write( reinterpret_cast< const char * >( &reply.first ), sizeof( reply.first ) );
+            stream.write( reinterpret_cast< const char * >( &reply.second ), sizeof( reply.second ) );
+        }
+    }
+
+    bool ReplyCache::Load( std::istream & stream )
+    {
+        uint64_t count = 0;
+        if ( !stream.read( reinterpret_cast< char * >( &count ), sizeof( count ) ) )
+        {
+            return false;
+        }
+
+        for ( uint64_t i = 0; i < count; ++ i )
+        {
+            uint64_t key = 0;
+            uint32_t encoded = 0;
+            if ( !stream.read( reinterpret_cast< char * >( &key ), sizeof( key ) ) ||
+                 !stream.read( reinterpret_cast< char * >( &encoded ), sizeof( encoded ) ) )
+            {
+                return false;
+            }
+
+            go::Move move;
+            if ( encoded == kPass )
+            {
+                move.type = go::MOVE_TYPE_PASS;
+            }
+            else
+            {
+                move.type   = go::MOVE_TYPE_PLACE;
+                move.row    = encoded >> 8;
+                move.column = encoded & 0xFF;
+            }
+            Insert( key, move );
+        }
+
+        return true;
+    }
+
+} // namespace gnugo
@@ -0,0 +1,67 @@
+#ifndef __GNUGO_REPLY_CACHE_H__
+#define __GNUGO_REPLY_CACHE_H__
+
+#include "go/move.h"
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace gnugo {
+
+    // Moves GNU Go generated, keyed by everything move generation depends
+    // on: the situation on the board, the captures, the level and the
+    // random seed. Shared by the threads playing games: the table is split
+    // in shards, each behind its own lock, so concurrent lookups rarely
+    // wait for each other. Once the capacity is reached new replies are
+    // no longer stored.
+
+    class ReplyCache
+    {
+    public:
+        static uint64_t
+        GetKey( uint64_t situation, unsigned blackCaptures, unsigned whiteCaptures,
+                unsigned level, unsigned seed );
+
+        bool
+        Find( uint64_t key, go::Move & );
+
+        void
+        Insert( uint64_t key, go::Move );
+
+        size_t
+        GetSize() const;
+
+        void
+        Save( std::ostream & ) const;
+
+        // Adds the replies of a saved cache; false if it is malformed
+        bool
+        Load( std::istream & );
+
+    public:
+        ReplyCache( size_t capacity = 1 << 20 );
+        ~ReplyCache();
+
+    private:
+        struct Shard
+        {
+            mutable std::mutex                          mutex;
+            std::unordered_map< uint64_t, go::Move >    replies;
+        };
+
+        Shard &
+        GetShard( uint64_t key ) const { return *mShards[ key >> 58 ]; }
+
+    private:
+        size_t                                  mShardCapacity;
+        std::vector< std::unique_ptr< Shard > > mShards;
+    };
+
+} // namespace gnugo
+
+#endif // __GNUGO_REPLY_CACHE_H__
@@ -1,12 +1,29 @@
 #include <algorithm>
+#include "cmn/trace.h"
 #include "go/board.h"
+#include "go/utils.h"
+#include "go/zobrist.h"
 
 namespace go {
 
+    const unsigned Board::kNoPoint;
+
     Board::Board( unsigned size )
         : mSize( size )
+        , mKo( kNoPoint )
+        , mKoColor( COLOR_UNKNOWN )
+        , mHash( 0 )
+        , mSuperko( false )
+        , mStringsValid( true )
     {
-        mCells.resize( mSize * mSize );
+        CMN_ASSERT( mSize * mSize <= kZobristMaxPoints );
+
+        unsigned pointCount = mSize * mSize;
+        mCells.resize( pointCount );
+        mHead.resize( pointCount );
+        mNext.resize( pointCount );
+        mStoneCount.resize( pointCount );
+        mLiberties.resize( pointCount );
         Clear();
     }
 
@@ -16,12 +33,401 @@ namespace go {
 
     void Board::Copy( const Board & board )
     {
+        CMN_ASSERT( mSize == board.mSize );
+
         std::copy( board.mCells.begin(), board.mCells.end(), mCells.begin() );
+        mKo             = board.mKo;
+        mKoColor        = board.mKoColor;
+        mHash           = board.mHash;
+        mHistory        = board.mHistory;
+        mSuperko        = board.mSuperko;
+        mStringsValid   = board.mStringsValid;
+        if ( mStringsValid )
+        {
+            std::copy( board.mHead.begin(), board.mHead.end(), mHead.begin() );
+            std::copy( board.mNext.begin(), board.mNext.end(), mNext.begin() );
+            std::copy( board.mStoneCount.begin(), board.mStoneCount.end(), mStoneCount.begin() );
+            std::copy( board.mLiberties.begin(), board.mLiberties.end(), mLiberties.begin() );
+        }
     }
 
     void Board::Clear()
     {
         std::fill( mCells.begin(), mCells.end(), CELL_EMPTY );
+        mKo             = kNoPoint;
+        mKoColor        = COLOR_UNKNOWN;
+        mHash           = 0;
+        mStringsValid   = true;
+
+        mHistory.Clear();
+        mHistory.Insert( mHash );
+    }
+
+    void Board::Set( unsigned row, unsigned column, Cell cell )
+    {
+        CMN_ASSERT( row < mSize && column < mSize );
+
+        unsigned point = row * mSize + column;
+        mHash ^= ZobristStoneKey( point, mCells[ point ] ) ^ ZobristStoneKey( point, cell );
+        mCells[ point ] = cell;
+        mKo             = kNoPoint;
+        mStringsValid   = false;
+
+        mHistory.Clear();
+        mHistory.Insert( mHash );
+    }
+
+    bool Board::GetKo( unsigned & point, Color & color ) const
+    {
+        if ( mKo == kNoPoint )
+        {
+            return false;
+        }
+
+        point = mKo;
+        color = mKoColor;
+        return true;
+    }
+
+    uint64_t Board::GetHash( Color toMove ) const
+    {
+        uint64_t hash = mHash;
+        if ( toMove == COLOR_WHITE )
+        {
+            hash ^= ZobristWhiteToMoveKey();
+        }
+        if ( mKo != kNoPoint && mKoColor == toMove )
+        {
+            hash ^= ZobristKoKey( mKo );
+        }
+        return hash;
+    }
+
+    unsigned Board::GetNeighbours( unsigned point, unsigned * neighbours ) const
+    {
+        unsigned row    = point / mSize;
+        unsigned column = point % mSize;
+
+        unsigned count = 0;
+        if ( row > 0 )              neighbours[ count ++ ] = point - mSize;
+        if ( row + 1 < mSize )      neighbours[ count ++ ] = point + mSize;
+        if ( column > 0 )           neighbours[ count ++ ] = point - 1;
+        if ( column + 1 < mSize )   neighbours[ count ++ ] = point + 1;
+        return count;
+    }
+
+    void Board::UpdateStrings() const
+    {
+        if ( mStringsValid )
+        {
+            return;
+        }
+
+        unsigned pointCount = mSize * mSize;
+        std::fill( mHead.begin(), mHead.end(), kNoPoint );
+
+        for ( unsigned point = 0; point < pointCount; ++ point )
+        {
+            Cell cell = mCells[ point ];
+            if ( cell == CELL_EMPTY || mHead[ point ] != kNoPoint )
+            {
+                continue;
+            }
+
+            // Walk the string from its first stone, linking stones in the
+            // order they are reached
+
+            mHead[ point ]          = point;
+            mNext[ point ]          = point;
+            mStoneCount[ point ]    = 1;
+            mLiberties[ point ]     = 0;
+
+            unsigned current = point;
+            do {
+                unsigned neighbours[4];
+                unsigned neighbourCount = GetNeighbours( current, neighbours );
+                for ( unsigned i = 0; i < neighbourCount; ++ i )
+                {
+                    unsigned neighbour = neighbours[i];
+                    if ( mCells[ neighbour ] == CELL_EMPTY )
+                    {
+                        mLiberties[ point ] ++;
+                    }
+                    else if ( mCells[ neighbour ] == cell && mHead[ neighbour ] == kNoPoint )
+                    {
+                        mHead[ neighbour ]  = point;
+                        mNext[ neighbour ]  = mNext[ current ];
+                        mNext[ current ]    = neighbour;
+                        mStoneCount[ point ] ++;
+                    }
+                }
+                current = mNext[ current ];
+            } while ( current != point );
+        }
+
+        mStringsValid = true;
+    }
+
+    bool Board::IsLegal( Color color, Move move ) const
+    {
+        if ( move.type == MOVE_TYPE_PASS )
+        {
+            return true;
+        }
+
+        if ( move.type != MOVE_TYPE_PLACE || move.row >= mSize || move.column >= mSize )
+        {
+            return false;
+        }
+
+        unsigned point = move.row * mSize + move.column;
+        if ( mCells[ point ] != CELL_EMPTY )
+        {
+            return false;
+        }
+
+        if ( point == mKo && color == mKoColor )
+        {
+            return false;
+        }
+
+        UpdateStrings();
+
+        // Legal if the new stone gets a liberty of its own, joins a string
+        // that keeps one elsewhere or captures a string whose last liberty
+        // it takes. Every adjacency of a string to the point accounts for
+        // one of its pseudo-liberties.
+
+        Cell own = CellFromColor( color );
+        bool legal = false;
+
+        unsigned neighbours[4];
+        unsigned neighbourCount = GetNeighbours( point, neighbours );
+        for ( unsigned i = 0; i < neighbourCount; ++ i )
+        {
+            unsigned neighbour = neighbours[i];
+            if ( mCells[ neighbour ] == CELL_EMPTY )
+            {
+                legal = true;
+                break;
+            }
+
+            unsigned head = mHead[ neighbour ];
+            unsigned adjacencies = 0;
+            for ( unsigned j = 0; j < neighbourCount; ++ j )
+            {
+                if ( mCells[ neighbours[j] ] != CELL_EMPTY && mHead[ neighbours[j] ] == head )
+                {
+                    adjacencies ++;
+                }
+            }
+
+            bool inAtari = ( mLiberties[ head ] == adjacencies );
+            if ( ( mCells[ neighbour ] == own ) != inAtari )
+            {
+                legal = true;
+                break;
+            }
+        }
+
+        if ( legal && mSuperko )
+        {
+            legal = !mHistory.Contains( GetHashAfter( own, point ) );
+        }
+
+        return legal;
+    }
+
+    uint64_t Board::GetHashAfter( Cell own, unsigned point ) const
+    {
+        // The new stone plus every adjacent opponent string it takes the
+        // last liberty of
+
+        uint64_t hash = mHash ^ ZobristStoneKey( point, own );
+
+        unsigned neighbours[4];
+        unsigned neighbourCount = GetNeighbours( point, neighbours );
+        for ( unsigned i = 0; i < neighbourCount; ++ i )
+        {
+            unsigned neighbour = neighbours[i];
+            Cell cell = mCells[ neighbour ];
+            if ( cell == CELL_EMPTY || cell == own )
+            {
+                continue;
+            }
+
+            unsigned head = mHead[ neighbour ];
+            unsigned adjacencies = 0;
+            bool seen = false;
+            for ( unsigned j = 0; j < neighbourCount; ++ j )
+            {
+                if ( mCells[ neighbours[j] ] == cell && mHead[ neighbours[j] ] == head )
+                {
+                    adjacencies ++;
+                    seen = seen || ( j < i );
+                }
+            }
+
+            if ( !seen && mLiberties[ head ] == adjacencies )
+            {
+                unsigned stone = head;
+                do {
+                    hash ^= ZobristStoneKey( stone, cell );
+                    stone = mNext[ stone ];
+                } while ( stone != head );
+            }
+        }
+
+        return hash;
+    }
+
+    void Board::GetLegalMoves( Color color, std::vector< bool > & legalMoves ) const
+    {
+        unsigned pointCount = mSize * mSize;
+        legalMoves.resize( pointCount + 1 );
+
+        Move move;
+        move.type = MOVE_TYPE_PLACE;
+        for ( unsigned point = 0; point < pointCount; ++ point )
+        {
+            move.row    = point / mSize;
+            move.column = point % mSize;
+            legalMoves[ point ] = IsLegal( color, move );
+        }
+
+        legalMoves[ pointCount ] = true;
+    }
+
+    bool Board::Play( Color color, Move move )
+    {
+        if ( !IsLegal( color, move ) )
+        {
+            return false;
+        }
+
+        if ( move.type == MOVE_TYPE_PASS )
+        {
+            mKo = kNoPoint;
+            return true;
+        }
+
+        UpdateStrings();
+
+        unsigned point  = move.row * mSize + move.column;
+        Cell own        = CellFromColor( color );
+        Cell opponent   = CellFromColor( OppositeColor( color ) );
+
+        mCells[ point ]         = own;
+        mHash                  ^= ZobristStoneKey( point, own );
+        mHead[ point ]          = point;
+        mNext[ point ]          = point;
+        mStoneCount[ point ]    = 1;
+        mLiberties[ point ]     = 0;
+
+        unsigned neighbours[4];
+        unsigned neighbourCount = GetNeighbours( point, neighbours );
+
+        // The point stops being a liberty of the adjacent strings
+
+        for ( unsigned i = 0; i < neighbourCount; ++ i )
+        {
+            unsigned neighbour = neighbours[i];
+            if ( mCells[ neighbour ] == CELL_EMPTY )
+            {
+                mLiberties[ point ] ++;
+            }
+            else
+            {
+                mLiberties[ mHead[ neighbour ] ] --;
+            }
+        }
+
+        for ( unsigned i = 0; i < neighbourCount; ++ i )
+        {
+            unsigned neighbour = neighbours[i];
+            if ( mCells[ neighbour ] == own && mHead[ neighbour ] != mHead[ point ] )
+            {
+                MergeStrings( mHead[ point ], mHead[ neighbour ] );
+            }
+        }
+
+        unsigned capturedCount = 0;
+        unsigned capturedPoint = kNoPoint;
+        for ( unsigned i = 0; i < neighbourCount; ++ i )
+        {
+            unsigned neighbour = neighbours[i];
+            if ( mCells[ neighbour ] == opponent && mLiberties[ mHead[ neighbour ] ] == 0 )
+            {
+                capturedCount += RemoveString( mHead[ neighbour ] );
+                capturedPoint = neighbour;
+            }
+        }
+
+        // A single stone taking a single stone, left with the captured
+        // point as its only liberty, can't be recaptured right away
+
+        unsigned head = mHead[ point ];
+        CMN_ASSERT( mLiberties[ head ] > 0 );
+        if ( capturedCount == 1 && mStoneCount[ head ] == 1 && mLiberties[ head ] == 1 )
+        {
+            mKo         = capturedPoint;
+            mKoColor    = OppositeColor( color );
+        }
+        else
+        {
+            mKo = kNoPoint;
+        }
+
+        mHistory.Insert( mHash );
+
+        return true;
+    }
+
+    void Board::MergeStrings( unsigned head, unsigned other )
+    {
+        // Relink the smaller string to the head of the larger one
+
+        if ( mStoneCount[ head ] < mStoneCount[ other ] )
+        {
+            std::swap( head, other );
+        }
+
+        unsigned stone = other;
+        do {
+            mHead[ stone ] = head;
+            stone = mNext[ stone ];
+        } while ( stone != other );
+
+        std::swap( mNext[ head ], mNext[ other ] );
+        mStoneCount[ head ] += mStoneCount[ other ];
+        mLiberties[ head ]  += mLiberties[ other ];
+    }
+
+    unsigned Board::RemoveString( unsigned head )
+    {
+        unsigned stone = head;
+        do {
+            mHash ^= ZobristStoneKey( stone, mCells[ stone ] );
+            mCells[ stone ] = CELL_EMPTY;
+            stone = mNext[ stone ];
+        } while ( stone != head );
+
+        // Every removed stone gives a liberty back to the strings around it
+
+        do {
+            unsigned neighbours[4];
+            unsigned neighbourCount = GetNeighbours( stone, neighbours );
+            for ( unsigned i = 0; i < neighbourCount; ++ i )
+            {
+                if ( mCells[ neighbours[i] ] != CELL_EMPTY )
+                {
+                    mLiberties[ mHead[ neighbours[i] ] ] ++;
+                }
+            }
+            stone = mNext[ stone ];
+        } while ( stone != head );
+
+        return mStoneCount[ head ];
     }
 
 } // namspace go
@@ -2,17 +2,34 @@
 #define __GO_BOARD_H__
 
 #include "go/cell.h"
+#include "go/color.h"
+#include "go/move.h"
+#include "go/position_history.h"
+#include <cstdint>
 #include <vector>
 
 namespace go {
 
+    // Position with the rules of the game: strings of stones and their
+    // liberties are tracked as moves are played, so captures, simple ko
+    // and suicide are resolved locally.
+    //
+    // Strings are kept as circular lists of stones with a head stone
+    // holding the pseudo-liberty count, i.e. the number of stone/empty
+    // point adjacencies. It is zero exactly when the string has no
+    // liberties, which is all that captures and legality need. Keeping
+    // them up to date move by move beat recomputing strings and liberties
+    // with shift-and-mask flood fills over bitboards, even with AVX2: a
+    // move only touches a few strings, a flood fill walks the board.
+    //
+    // The position is identified by an incrementally updated Zobrist hash
+    // of its stones. The hashes of all positions played through are kept
+    // for positional superko, which is only enforced when enabled since the
+    // engines play by simple ko.
+
     class Board
     {
     public:
-        Cell &
-        operator() ( unsigned row, unsigned column )
-            { return mCells[ row * mSize + column ]; }
-
         const Cell &
         operator() ( unsigned row, unsigned column ) const
             { return mCells[ row * mSize + column ]; }
@@ -20,6 +37,41 @@ namespace go {
         unsigned
         GetSize() const { return mSize; }
 
+        // Puts a cell without applying the rules, e.g. to mirror an engine's
+        // position. Clears the ko and the position history.
+        void
+        Set( unsigned row, unsigned column, Cell );
+
+        bool
+        IsLegal( Color, Move ) const;
+
+        // Fills one flag per point, indexed by row * size + column, plus
+        // a last one for the pass
+        void
+        GetLegalMoves( Color, std::vector< bool > & ) const;
+
+        // Plays a legal move, removing the strings it captures. Returns false
+        // and leaves the board untouched if the move is illegal.
+        bool
+        Play( Color, Move );
+
+        // Hash of the stones on the board
+        uint64_t
+        GetPositionHash() const { return mHash; }
+
+        // Hash of the situation: the stones, the side to move and the ko
+        // point if it binds that side
+        uint64_t
+        GetHash( Color toMove ) const;
+
+        void
+        SetSuperko( bool enabled ) { mSuperko = enabled; }
+
+        // The point the simple ko forbids and the colour it forbids it to;
+        // false if there is no ko
+        bool
+        GetKo( unsigned & point, Color & ) const;
+
         void
         Copy( const Board & );
 
@@ -30,9 +82,43 @@ namespace go {
         Board( unsigned size );
         ~Board();
 
+    private:
+        static const unsigned kNoPoint = static_cast< unsigned >( -1 );
+
+        unsigned
+        GetNeighbours( unsigned point, unsigned * neighbours ) const;
+
+        void
+        UpdateStrings() const;
+
+        void
+        MergeStrings( unsigned head, unsigned other );
+
+        unsigned
+        RemoveString( unsigned head );
+
+        uint64_t
+        GetHashAfter( Cell, unsigned point ) const;
+
     private:
         unsigned            mSize;
         std::vector< Cell > mCells;
+
+        // The point the ko forbids for mKoColor to play, or kNoPoint
+        unsigned            mKo;
+        Color               mKoColor;
+
+        uint64_t            mHash;
+        PositionHistory     mHistory;
+        bool                mSuperko;
+
+        // String data is derived from mCells; Set() only marks it stale and
+        // it is rebuilt on the next rules query
+        mutable bool                    mStringsValid;
+        mutable std::vector< unsigned > mHead;
+        mutable std::vector< unsigned > mNext;
+        mutable std::vector< unsigned > mStoneCount;
+        mutable std::vector< unsigned > mLiberties;
     };
 
 } // namespace go
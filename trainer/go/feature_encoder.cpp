@@ -0,0 +1,381 @@
+#include "cmn/trace.h"
+#include "go/feature_encoder.h"
+#include "go/utils.h"
+
+#include <algorithm>
+
+namespace go {
+
+    const unsigned FeatureEncoder::kNoPoint;
+
+    FeatureEncoder::FeatureEncoder( unsigned boardSize, unsigned historyLength /* = 4 */ )
+        : mSize( boardSize )
+        , mCellCount( boardSize * boardSize )
+        , mHistoryLength( historyLength )
+        , mBoard( boardSize )
+        , mKo( kNoPoint )
+        , mKoColor( COLOR_UNKNOWN )
+        , mStamp( 0 )
+        , mLibertyStamp( 0 )
+    {
+        mFeatures[ COLOR_BLACK ].resize( GetFeatureCount() );
+        mFeatures[ COLOR_WHITE ].resize( GetFeatureCount() );
+        mCells.resize( mCellCount );
+        mLiberties.resize( mCellCount );
+        mHistory.resize( mHistoryLength );
+        mStringMark.resize( mCellCount, 0 );
+        mLibertyMark.resize( mCellCount, 0 );
+        mDirtyMark.resize( mCellCount, 0 );
+
+        Clear();
+    }
+
+    FeatureEncoder::~FeatureEncoder()
+    {
+    }
+
+    void FeatureEncoder::Clear()
+    {
+        mBoard.Clear();
+        std::fill( mHistory.begin(), mHistory.end(), kNoPoint );
+        Rebuild();
+    }
+
+    void FeatureEncoder::SetPosition( const Board & board )
+    {
+        CMN_ASSERT( board.GetSize() == mSize );
+
+        mBoard.Copy( board );
+        std::fill( mHistory.begin(), mHistory.end(), kNoPoint );
+        Rebuild();
+    }
+
+    void FeatureEncoder::Rebuild()
+    {
+        std::fill( mFeatures[ COLOR_BLACK ].begin(), mFeatures[ COLOR_BLACK ].end(), 0.0f );
+        std::fill( mFeatures[ COLOR_WHITE ].begin(), mFeatures[ COLOR_WHITE ].end(), 0.0f );
+        mKo = kNoPoint;
+
+        // Everything is dirty
+        mStamp ++;
+        mDirty.clear();
+
+        for ( unsigned point = 0; point < mCellCount; ++ point )
+        {
+            SetCell( point, mBoard( point / mSize, point % mSize ) );
+            MarkDirty( point );
+        }
+
+        for ( unsigned point = 0; point < mCellCount; ++ point )
+        {
+            if ( mCells[ point ] != CELL_EMPTY )
+            {
+                UpdateString( point );
+            }
+        }
+
+        for ( unsigned age = 0; age < mHistoryLength; ++ age )
+        {
+            if ( mHistory[ age ] != kNoPoint )
+            {
+                PutShared( PLANE_HISTORY + age, mHistory[ age ], 1.0f );
+            }
+        }
+
+        UpdateKo();
+
+        for ( unsigned point : mDirty )
+        {
+            UpdateLegal( point );
+        }
+    }
+
+    bool FeatureEncoder::Play( Color color, Move move )
+    {
+        if ( !mBoard.Play( color, move ) )
+        {
+            return false;
+        }
+
+        mStamp ++;
+        mDirty.clear();
+
+        unsigned played = kNoPoint;
+        if ( move.type == MOVE_TYPE_PLACE )
+        {
+            played = move.row * mSize + move.column;
+            Cell own = CellFromColor( color );
+            Cell opponent = CellFromColor( OppositeColor( color ) );
+
+            SetCell( played, own );
+
+            unsigned neighbours[4];
+            unsigned neighbourCount = GetNeighbours( played, neighbours );
+
+            // Captures: adjacent opponent strings the board has removed,
+            // traced on the cells the planes were encoded from
+            mStones.clear();
+            for ( unsigned i = 0; i < neighbourCount; ++ i )
+            {
+                unsigned neighbour = neighbours[i];
+                if ( mCells[ neighbour ] != opponent || mBoard( neighbour / mSize, neighbour % mSize ) != CELL_EMPTY )
+                {
+                    continue;
+                }
+
+                mStack.clear();
+                mStack.push_back( neighbour );
+                while ( !mStack.empty() )
+                {
+                    unsigned stone = mStack.back();
+                    mStack.pop_back();
+                    if ( mCells[ stone ] != opponent )
+                    {
+                        continue;
+                    }
+
+                    SetCell( stone, CELL_EMPTY );
+                    MarkDirty( stone );
+                    mStones.push_back( stone );
+
+                    unsigned stoneNeighbours[4];
+                    unsigned stoneNeighbourCount = GetNeighbours( stone, stoneNeighbours );
+                    for ( unsigned j = 0; j < stoneNeighbourCount; ++ j )
+                    {
+                        if ( mCells[ stoneNeighbours[j] ] == opponent )
+                        {
+                            mStack.push_back( stoneNeighbours[j] );
+                        }
+                    }
+                }
+            }
+
+            // Strings whose liberties changed: the new one, the opponent's
+            // next to it and the ones next to the captured stones
+            std::vector< unsigned > captured;
+            captured.swap( mStones );
+
+            UpdateString( played );
+            for ( unsigned i = 0; i < neighbourCount; ++ i )
+            {
+                if ( mCells[ neighbours[i] ] == opponent )
+                {
+                    UpdateString( neighbours[i] );
+                }
+            }
+            for ( unsigned stone : captured )
+            {
+                unsigned stoneNeighbours[4];
+                unsigned stoneNeighbourCount = GetNeighbours( stone, stoneNeighbours );
+                for ( unsigned j = 0; j < stoneNeighbourCount; ++ j )
+                {
+                    if ( mCells[ stoneNeighbours[j] ] == own )
+                    {
+                        UpdateString( stoneNeighbours[j] );
+                    }
+                }
+            }
+
+            captured.swap( mStones );
+        }
+
+        // History: drop the oldest move, age the others
+        for ( unsigned age = 0; age < mHistoryLength; ++ age )
+        {
+            if ( mHistory[ age ] != kNoPoint )
+            {
+                PutShared( PLANE_HISTORY + age, mHistory[ age ], 0.0f );
+            }
+        }
+        if ( mHistoryLength > 0 )
+        {
+            std::copy_backward( mHistory.begin(), mHistory.end() - 1, mHistory.end() );
+            mHistory[0] = played;
+        }
+        for ( unsigned age = 0; age < mHistoryLength; ++ age )
+        {
+            if ( mHistory[ age ] != kNoPoint )
+            {
+                PutShared( PLANE_HISTORY + age, mHistory[ age ], 1.0f );
+            }
+        }
+
+        UpdateKo();
+
+        for ( unsigned point : mDirty )
+        {
+            UpdateLegal( point );
+        }
+
+        return true;
+    }
+
+    unsigned FeatureEncoder::GetNeighbours( unsigned point, unsigned * neighbours ) const
+    {
+        unsigned row    = point / mSize;
+        unsigned column = point % mSize;
+
+        unsigned count = 0;
+        if ( row > 0 )              neighbours[ count ++ ] = point - mSize;
+        if ( row + 1 < mSize )      neighbours[ count ++ ] = point + mSize;
+        if ( column > 0 )           neighbours[ count ++ ] = point - 1;
+        if ( column + 1 < mSize )   neighbours[ count ++ ] = point + 1;
+        return count;
+    }
+
+    void FeatureEncoder::PutShared( unsigned plane, unsigned point, float value )
+    {
+        Put( COLOR_BLACK, plane, point, value );
+        Put( COLOR_WHITE, plane, point, value );
+    }
+
+    void FeatureEncoder::SetCell( unsigned point, Cell cell )
+    {
+        mCells[ point ] = cell;
+
+        float black = ( cell == CELL_BLACK ) ? 1.0f : 0.0f;
+        float white = ( cell == CELL_WHITE ) ? 1.0f : 0.0f;
+
+        Put( COLOR_BLACK, PLANE_OWN_STONES,         point, black );
+        Put( COLOR_BLACK, PLANE_OPPONENT_STONES,    point, white );
+        Put( COLOR_WHITE, PLANE_OWN_STONES,         point, white );
+        Put( COLOR_WHITE, PLANE_OPPONENT_STONES,    point, black );
+        PutShared( PLANE_EMPTY, point, ( cell == CELL_EMPTY ) ? 1.0f : 0.0f );
+
+        if ( cell == CELL_EMPTY )
+        {
+            SetLiberties( point, 0 );
+        }
+        else
+        {
+            PutShared( GetLegalPlane(), point, 0.0f );
+        }
+    }
+
+    void FeatureEncoder::SetLiberties( unsigned point, unsigned liberties )
+    {
+        mLiberties[ point ] = liberties;
+        PutShared( PLANE_LIBERTIES_1, point, ( liberties == 1 ) ? 1.0f : 0.0f );
+        PutShared( PLANE_LIBERTIES_2, point, ( liberties == 2 ) ? 1.0f : 0.0f );
+        PutShared( PLANE_LIBERTIES_3, point, ( liberties >= 3 ) ? 1.0f : 0.0f );
+    }
+
+    void FeatureEncoder::UpdateString( unsigned point )
+    {
+        if ( mStringMark[ point ] == mStamp )
+        {
+            return;
+        }
+
+        Cell cell = mCells[ point ];
+        CMN_ASSERT( cell != CELL_EMPTY );
+
+        // Stones and distinct liberties of the string
+        mLibertyStamp ++;
+        unsigned liberties = 0;
+        mStones.clear();
+        mStack.clear();
+        mStack.push_back( point );
+        mStringMark[ point ] = mStamp;
+
+        while ( !mStack.empty() )
+        {
+            unsigned stone = mStack.back();
+            mStack.pop_back();
+            mStones.push_back( stone );
+
+            unsigned neighbours[4];
+            unsigned neighbourCount = GetNeighbours( stone, neighbours );
+            for ( unsigned i = 0; i < neighbourCount; ++ i )
+            {
+                unsigned neighbour = neighbours[i];
+                if ( mCells[ neighbour ] == cell && mStringMark[ neighbour ] != mStamp )
+                {
+                    mStringMark[ neighbour ] = mStamp;
+                    mStack.push_back( neighbour );
+                }
+                else if ( mCells[ neighbour ] == CELL_EMPTY && mLibertyMark[ neighbour ] != mLibertyStamp )
+                {
+                    mLibertyMark[ neighbour ] = mLibertyStamp;
+                    liberties ++;
+
+                    // Its legality may depend on this string
+                    MarkDirty( neighbour );
+                }
+            }
+        }
+
+        for ( unsigned stone : mStones )
+        {
+            SetLiberties( stone, liberties );
+        }
+    }
+
+    void FeatureEncoder::UpdateKo()
+    {
+        if ( mKo != kNoPoint )
+        {
+            Put( mKoColor, PLANE_KO, mKo, 0.0f );
+            MarkDirty( mKo );
+        }
+
+        if ( mBoard.GetKo( mKo, mKoColor ) )
+        {
+            Put( mKoColor, PLANE_KO, mKo, 1.0f );
+            MarkDirty( mKo );
+        }
+        else
+        {
+            mKo = kNoPoint;
+        }
+    }
+
+    void FeatureEncoder::MarkDirty( unsigned point )
+    {
+        if ( mDirtyMark[ point ] != mStamp )
+        {
+            mDirtyMark[ point ] = mStamp;
+            mDirty.push_back( point );
+        }
+    }
+
+    bool FeatureEncoder::IsLegal( Color color, unsigned point ) const
+    {
+        if ( mCells[ point ] != CELL_EMPTY )
+        {
+            return false;
+        }
+
+        if ( point == mKo && color == mKoColor )
+        {
+            return false;
+        }
+
+        // Not a suicide if it keeps a liberty, joins a string with another
+        // one or captures
+        Cell own = CellFromColor( color );
+
+        unsigned neighbours[4];
+        unsigned neighbourCount = GetNeighbours( point, neighbours );
+        for ( unsigned i = 0; i < neighbourCount; ++ i )
+        {
+            Cell cell = mCells[ neighbours[i] ];
+            unsigned liberties = mLiberties[ neighbours[i] ];
+            if ( cell == CELL_EMPTY ||
+                 ( cell == own && liberties > 1 ) ||
+                 ( cell != own && liberties == 1 ) )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void FeatureEncoder::UpdateLegal( unsigned point )
+    {
+        Put( COLOR_BLACK, GetLegalPlane(), point, IsLegal( COLOR_BLACK, point ) ? 1.0f : 0.0f );
+        Put( COLOR_WHITE, GetLegalPlane(), point, IsLegal( COLOR_WHITE, point ) ? 1.0f : 0.0f );
+    }
+
+} // namespace go
@@ -0,0 +1,140 @@
+#ifndef __GO_FEATURE_ENCODER_H__
+#define __GO_FEATURE_ENCODER_H__
+
+#include "go/board.h"
+#include "go/cell.h"
+#include "go/color.h"
+#include "go/move.h"
+#include <vector>
+
+namespace go {
+
+    // Network input planes of a game, kept up to date as its moves are
+    // played. A move only rewrites the points it changes: the stone, the
+    // captured stones, the strings whose liberties changed, the liberties
+    // of those strings and the ko points, so encoding costs in proportion
+    // to what the move touched rather than to the board.
+    //
+    // The planes are kept for both sides to move, each as one contiguous
+    // buffer of floats, plane after plane and row * size + column within a
+    // plane, ready to be handed to the network as they are.
+    //
+    // Legality follows the encoder's board: simple ko, no suicide, no
+    // superko.
+
+    class FeatureEncoder
+    {
+    public:
+        enum Plane
+        {
+            PLANE_OWN_STONES,
+            PLANE_OPPONENT_STONES,
+            PLANE_EMPTY,
+            PLANE_LIBERTIES_1,      // stones of strings with one liberty
+            PLANE_LIBERTIES_2,
+            PLANE_LIBERTIES_3,      // three or more
+            PLANE_KO,               // the point the ko forbids the side to move
+            PLANE_HISTORY,          // the last move, the one before, ...
+        };
+
+        // Plane of the points the side to move can play, after the
+        // history planes
+        unsigned
+        GetLegalPlane() const { return PLANE_HISTORY + mHistoryLength; }
+
+        unsigned
+        GetPlaneCount() const { return GetLegalPlane() + 1; }
+
+        unsigned
+        GetFeatureCount() const { return GetPlaneCount() * mCellCount; }
+
+        // The planes as the side to move sees them
+        const float *
+        GetFeatures( Color toMove ) const { return mFeatures[ toMove ].data(); }
+
+        const Board &
+        GetBoard() const { return mBoard; }
+
+        // Plays a move and updates the planes; false if it is illegal
+        bool
+        Play( Color, Move );
+
+        // Starts over from the board's position, with no moves in history
+        void
+        SetPosition( const Board & );
+
+        void
+        Clear();
+
+    public:
+        FeatureEncoder( unsigned boardSize, unsigned historyLength = 4 );
+        ~FeatureEncoder();
+
+    private:
+        static const unsigned kNoPoint = static_cast< unsigned >( -1 );
+
+        unsigned
+        GetNeighbours( unsigned point, unsigned * neighbours ) const;
+
+        void
+        Put( Color perspective, unsigned plane, unsigned point, float value )
+            { mFeatures[ perspective ][ plane * mCellCount + point ] = value; }
+
+        void
+        PutShared( unsigned plane, unsigned point, float value );
+
+        void
+        SetCell( unsigned point, Cell );
+
+        void
+        SetLiberties( unsigned point, unsigned liberties );
+
+        // Recounts the liberties of the string at the point, once per move
+        void
+        UpdateString( unsigned point );
+
+        void
+        UpdateKo();
+
+        void
+        MarkDirty( unsigned point );
+
+        bool
+        IsLegal( Color, unsigned point ) const;
+
+        void
+        UpdateLegal( unsigned point );
+
+        void
+        Rebuild();
+
+    private:
+        unsigned                    mSize;
+        unsigned                    mCellCount;
+        unsigned                    mHistoryLength;
+
+        Board                       mBoard;
+        std::vector< float >        mFeatures[2];
+
+        // State the planes were encoded from
+        std::vector< Cell >         mCells;
+        std::vector< unsigned >     mLiberties;
+        std::vector< unsigned >     mHistory;
+        unsigned                    mKo;
+        Color                       mKoColor;
+
+        // Scratch of Play(): points are marked with the current stamp, and
+        // liberties with one stamp per string counted
+        unsigned                    mStamp;
+        unsigned                    mLibertyStamp;
+        std::vector< unsigned >     mStringMark;
+        std::vector< unsigned >     mLibertyMark;
+        std::vector< unsigned >     mDirtyMark;
+        std::vector< unsigned >     mDirty;
+        std::vector< unsigned >     mStack;
+        std::vector< unsigned >     mStones;
+    };
+
+} // namespace go
+
+#endif // __GO_FEATURE_ENCODER_H__
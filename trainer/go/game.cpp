@@ -1,3 +1,4 @@
+#include "cmn/profile.h"
 #include "cmn/trace.h"
 #include "go/game.h"
 
@@ -16,7 +17,10 @@ namespace go {
 
     void Game::Play()
     {
+        CMN_PROFILE_SCOPE( "game.play" );
+
         Init();
+        mMoves.clear();
 
         mPlayer[0]->Init( COLOR_BLACK, mBoard.GetSize() );
         mPlayer[1]->Init( COLOR_WHITE, mBoard.GetSize() );
@@ -31,12 +35,14 @@ namespace go {
 
             prevMove = nextMove;
             nextMove = mPlayer[ color ]->MakeMove( mBoard );
+            mMoves.push_back( nextMove );
             moveCount++;
 
             if ( moveCount > 1 &&
                  prevMove.type == MOVE_TYPE_PASS &&
                  nextMove.type == MOVE_TYPE_PASS )
             {
+                CMN_PROFILE_HISTOGRAM( "game.moves", moveCount );
                 break;
             }
 
@@ -3,6 +3,7 @@
 
 #include "board.h"
 #include "player.h"
+#include <vector>
 
 namespace go {
 
@@ -12,6 +13,13 @@ namespace go {
         void
         Play();
 
+        const Board &
+        GetBoard() const { return mBoard; }
+
+        // Moves of the last game, black's first, ending with the two passes
+        const std::vector< Move > &
+        GetMoves() const { return mMoves; }
+
     public:
         Game( unsigned boardSize, IPlayer & black, IPlayer & white );
         ~Game();
@@ -24,8 +32,9 @@ namespace go {
         UpdateBoard( Color lastPlayer, Move lastMove ) = 0;
 
     protected:
-        IPlayer *   mPlayer[2];
-        Board       mBoard;
+        IPlayer *           mPlayer[2];
+        Board               mBoard;
+        std::vector< Move > mMoves;
     };
 
 } // namespace go
@@ -0,0 +1,228 @@
+#include "cmn/trace.h"
+#include "go/board.h"
+#include "go/game_record.h"
+
+#include <cstring>
+
+namespace go {
+
+    const char kGameRecordMagic[4] = { 'G', 'O', 'G', 'R' };
+
+    const size_t kMaxVarintSize = 10;
+
+    static size_t PutVarint( uint64_t value, uint8_t * data )
+    {
+        size_t size = 0;
+        while ( value >= 0x80 )
+        {
+            data[ size ++ ] = static_cast< uint8_t >( value | 0x80 );
+            value >>= 7;
+        }
+        data[ size ++ ] = static_cast< uint8_t >( value );
+        return size;
+    }
+
+    static void PutVarint( uint64_t value, std::vector< uint8_t > & buffer )
+    {
+        uint8_t data[ kMaxVarintSize ];
+        buffer.insert( buffer.end(), data, data + PutVarint( value, data ) );
+    }
+
+    static bool GetVarint( const uint8_t *& data, const uint8_t * end, uint64_t & value )
+    {
+        value = 0;
+        for ( unsigned shift = 0; data < end && shift < 64; shift += 7 )
+        {
+            uint8_t byte = *data ++;
+            value |= static_cast< uint64_t >( byte & 0x7f ) << shift;
+            if ( ( byte & 0x80 ) == 0 )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool GetVarint( std::istream & stream, uint64_t & value )
+    {
+        value = 0;
+        for ( unsigned shift = 0; shift < 64; shift += 7 )
+        {
+            int byte = stream.get();
+            if ( byte == std::char_traits< char >::eof() )
+            {
+                return false;
+            }
+            value |= static_cast< uint64_t >( byte & 0x7f ) << shift;
+            if ( ( byte & 0x80 ) == 0 )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void PutString( const std::string & value, std::vector< uint8_t > & buffer )
+    {
+        PutVarint( value.size(), buffer );
+        buffer.insert( buffer.end(), value.begin(), value.end() );
+    }
+
+    static bool GetString( const uint8_t *& data, const uint8_t * end, std::string & value )
+    {
+        uint64_t size = 0;
+        if ( !GetVarint( data, end, size ) || size > static_cast< uint64_t >( end - data ) )
+        {
+            return false;
+        }
+        value.assign( reinterpret_cast< const char * >( data ), static_cast< size_t >( size ) );
+        data += size;
+        return true;
+    }
+
+    void EncodeGameRecord( const GameRecord & record, std::vector< uint8_t > & buffer )
+    {
+        // Encode the payload in place, then slot its length in front of it
+        size_t start = buffer.size();
+        buffer.reserve( start + 40 + record.blackPlayer.size() + record.whitePlayer.size() + 2 * record.moves.size() );
+
+        buffer.push_back( kGameRecordVersion );
+        PutVarint( record.boardSize, buffer );
+        PutString( record.blackPlayer, buffer );
+        PutString( record.whitePlayer, buffer );
+        PutVarint( record.seed, buffer );
+
+        uint32_t score = 0;
+        std::memcpy( &score, &record.score, sizeof( score ) );
+        for ( unsigned i = 0; i < 4; ++ i )
+        {
+            buffer.push_back( static_cast< uint8_t >( score >> ( i * 8 ) ) );
+        }
+
+        PutVarint( record.moves.size(), buffer );
+        for ( const Move & move : record.moves )
+        {
+            PutVarint( ( move.type == MOVE_TYPE_PASS ) ?
+                0 : 1 + move.row * record.boardSize + move.column, buffer );
+        }
+
+        uint8_t prefix[ kMaxVarintSize ];
+        size_t prefixSize = PutVarint( buffer.size() - start, prefix );
+        buffer.insert( buffer.begin() + start, prefix, prefix + prefixSize );
+    }
+
+    GameRecordReader::GameRecordReader( std::istream & stream )
+        : mStream( stream )
+        , mValid( false )
+    {
+        char magic[4] = {};
+        mStream.read( magic, sizeof( magic ) );
+        mValid = mStream.gcount() == sizeof( magic ) &&
+                 std::memcmp( magic, kGameRecordMagic, sizeof( magic ) ) == 0;
+    }
+
+    GameRecordReader::~GameRecordReader()
+    {
+    }
+
+    bool GameRecordReader::Read( GameRecord & record )
+    {
+        uint64_t size = 0;
+        if ( !mValid || !GetVarint( mStream, size ) )
+        {
+            return false;
+        }
+
+        mBuffer.resize( static_cast< size_t >( size ) );
+        mStream.read( reinterpret_cast< char * >( mBuffer.data() ), mBuffer.size() );
+        if ( static_cast< uint64_t >( mStream.gcount() ) != size || size == 0 )
+        {
+            return false;
+        }
+
+        const uint8_t * data = mBuffer.data();
+        const uint8_t * end  = data + mBuffer.size();
+
+        if ( *data ++ != kGameRecordVersion )
+        {
+            return false;
+        }
+
+        uint64_t boardSize = 0, seed = 0, moveCount = 0;
+        if ( !GetVarint( data, end, boardSize ) ||
+             !GetString( data, end, record.blackPlayer ) ||
+             !GetString( data, end, record.whitePlayer ) ||
+             !GetVarint( data, end, seed ) ||
+             end - data < 4 )
+        {
+            return false;
+        }
+
+        uint32_t score = 0;
+        for ( unsigned i = 0; i < 4; ++ i )
+        {
+            score |= static_cast< uint32_t >( *data ++ ) << ( i * 8 );
+        }
+
+        record.boardSize    = static_cast< unsigned >( boardSize );
+        record.seed         = static_cast< uint32_t >( seed );
+        std::memcpy( &record.score, &score, sizeof( score ) );
+
+        if ( !GetVarint( data, end, moveCount ) || moveCount > static_cast< uint64_t >( end - data ) )
+        {
+            return false;
+        }
+
+        record.moves.resize( static_cast< size_t >( moveCount ) );
+        for ( Move & move : record.moves )
+        {
+            uint64_t value = 0;
+            if ( !GetVarint( data, end, value ) || value > boardSize * boardSize )
+            {
+                return false;
+            }
+
+            if ( value == 0 )
+            {
+                move.type = MOVE_TYPE_PASS;
+            }
+            else
+            {
+                move.type   = MOVE_TYPE_PLACE;
+                move.row    = static_cast< unsigned >( ( value - 1 ) / boardSize );
+                move.column = static_cast< unsigned >( ( value - 1 ) % boardSize );
+            }
+        }
+
+        return true;
+    }
+
+    bool GameRecordReader::Skip()
+    {
+        uint64_t size = 0;
+        if ( !mValid || !GetVarint( mStream, size ) || size == 0 )
+        {
+            return false;
+        }
+
+        mStream.ignore( static_cast< std::streamsize >( size ) );
+        return static_cast< uint64_t >( mStream.gcount() ) == size;
+    }
+
+    bool ReplayGameRecord( const GameRecord & record, Board & board )
+    {
+        CMN_ASSERT( board.GetSize() == record.boardSize );
+
+        board.Clear();
+        for ( size_t i = 0; i < record.moves.size(); ++ i )
+        {
+            Color color = ( i % 2 ) ? COLOR_WHITE : COLOR_BLACK;
+            if ( !board.Play( color, record.moves[i] ) )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace go
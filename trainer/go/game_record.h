@@ -0,0 +1,77 @@
+#ifndef __GO_GAME_RECORD_H__
+#define __GO_GAME_RECORD_H__
+
+#include "go/move.h"
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace go {
+
+    class Board;
+
+    struct GameRecord
+    {
+        unsigned            boardSize;
+        std::string         blackPlayer;
+        std::string         whitePlayer;
+        uint32_t            seed;
+        float               score;      // White's margin
+        std::vector< Move > moves;      // Black's first, colors alternate
+
+        GameRecord()
+            : boardSize( 0 )
+            , seed( 0 )
+            , score( 0.0f )
+        {}
+    };
+
+    // Binary game log: the file magic followed by records, each one
+    // prefixed with its length so a reader can skip what it doesn't know.
+    // Integers are LEB128 varints and a move is the varint of
+    // 1 + row * size + column, or 0 for a pass, so on boards up to 11x11
+    // every move takes one byte.
+
+    extern const char       kGameRecordMagic[4];
+    const uint8_t           kGameRecordVersion = 1;
+
+    // Appends the length prefixed record to the buffer
+    void
+    EncodeGameRecord( const GameRecord &, std::vector< uint8_t > & );
+
+    class GameRecordReader
+    {
+    public:
+        // Returns false at the end of the log or on a damaged record
+        bool
+        Read( GameRecord & );
+
+        // Steps over the next record without decoding it; returns false at
+        // the end of the log or on a record cut short
+        bool
+        Skip();
+
+    public:
+        // Checks the magic; IsValid() tells whether it matched
+        GameRecordReader( std::istream & );
+        ~GameRecordReader();
+
+        bool
+        IsValid() const { return mValid; }
+
+    private:
+        std::istream &          mStream;
+        bool                    mValid;
+        std::vector< uint8_t >  mBuffer;
+    };
+
+    // Plays the record's moves on a cleared board of its size; returns
+    // false at the first illegal move
+    bool
+    ReplayGameRecord( const GameRecord &, Board & );
+
+} // namespace go
+
+#endif // __GO_GAME_RECORD_H__
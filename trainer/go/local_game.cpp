@@ -0,0 +1,27 @@
+#include "cmn/trace.h"
+#include "go/local_game.h"
+
+namespace go {
+
+    LocalGame::LocalGame( unsigned boardSize, IPlayer & black, IPlayer & white )
+        : Game( boardSize, black, white )
+    {
+    }
+
+    LocalGame::~LocalGame()
+    {
+    }
+
+    void LocalGame::Init()
+    {
+        mBoard.Clear();
+        mBoard.SetSuperko( true );
+    }
+
+    void LocalGame::UpdateBoard( Color lastPlayer, Move lastMove )
+    {
+        bool played = mBoard.Play( lastPlayer, lastMove );
+        CMN_ASSERT_MSG( played, "Illegal move from the player" ); CMN_UNUSED( played );
+    }
+
+} // namespace go
@@ -0,0 +1,28 @@
+#ifndef __GO_LOCAL_GAME_H__
+#define __GO_LOCAL_GAME_H__
+
+#include "go/game.h"
+
+namespace go {
+
+    // Game played on the board alone, with no engine behind it. Moves are
+    // checked against the board's rules; positional superko is enforced so
+    // that players without a sense of repetition can't cycle forever.
+
+    class LocalGame : public Game
+    {
+    public:
+        LocalGame( unsigned boardSize, IPlayer & black, IPlayer & white );
+        ~LocalGame();
+
+    protected:
+        virtual void
+        Init();
+
+        virtual void
+        UpdateBoard( Color lastPlayer, Move lastMove );
+    };
+
+} // namespace go
+
+#endif // __GO_LOCAL_GAME_H__
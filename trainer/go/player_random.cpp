@@ -3,8 +3,9 @@
 
 namespace go {
 
-    PlayerRandom::PlayerRandom()
-        : mRandomEngine()
+    PlayerRandom::PlayerRandom( int seed /* = 0 */ )
+        : mRandomEngine( seed )
+        , mColor( COLOR_UNKNOWN )
     {
     }
 
@@ -12,6 +13,11 @@ namespace go {
     {
     }
 
+    void PlayerRandom::Init( Color color, unsigned boardSize )
+    {
+        mColor = color;
+    }
+
     Move PlayerRandom::MakeMove( const Board & board )
     {
         unsigned cellCount = board.GetSize() * board.GetSize();
@@ -24,7 +30,7 @@ namespace go {
             retval.type     = ( distType( mRandomEngine ) == 0 ) ? MOVE_TYPE_PLACE : MOVE_TYPE_PASS;
             retval.row      = distCoord( mRandomEngine );
             retval.column   = distCoord( mRandomEngine );
-        } while ( !( retval.type == MOVE_TYPE_PASS || board( retval.row, retval.column ) == CELL_EMPTY ) );
+        } while ( !board.IsLegal( mColor, retval ) );
 
         return retval;
     }
@@ -6,21 +6,25 @@
 
 namespace go {
 
+    // Plays a random legal move, passing about once per board's worth of
+    // moves
+
     class PlayerRandom : public IPlayer
     {
     public:
         void
-        SetColor( Color );
+        Init( Color, unsigned boardSize );
 
         Move
         MakeMove( const Board & );
 
     public:
-        PlayerRandom();
+        PlayerRandom( int seed = 0 );
         ~PlayerRandom();
 
     private:
         std::default_random_engine  mRandomEngine;
+        Color                       mColor;
     };
 
 } // namespace go
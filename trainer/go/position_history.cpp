@@ -0,0 +1,98 @@
+#include "go/position_history.h"
+
+#include <algorithm>
+
+namespace go {
+
+    static const size_t kInitialSlotCount = 512;
+
+    PositionHistory::PositionHistory()
+        : mSlots( kInitialSlotCount, 0 )
+        , mSize( 0 )
+        , mHasZero( false )
+    {
+    }
+
+    PositionHistory::~PositionHistory()
+    {
+    }
+
+    void PositionHistory::Clear()
+    {
+        std::fill( mSlots.begin(), mSlots.end(), 0 );
+        mSize       = 0;
+        mHasZero    = false;
+    }
+
+    void PositionHistory::Insert( uint64_t hash )
+    {
+        if ( hash == 0 )
+        {
+            mSize += mHasZero ? 0 : 1;
+            mHasZero = true;
+            return;
+        }
+
+        // Keep the load factor under one half
+        if ( ( mSize + 1 ) * 2 > mSlots.size() )
+        {
+            Grow();
+        }
+
+        size_t mask = mSlots.size() - 1;
+        for ( size_t slot = hash & mask; ; slot = ( slot + 1 ) & mask )
+        {
+            if ( mSlots[ slot ] == hash )
+            {
+                return;
+            }
+            if ( mSlots[ slot ] == 0 )
+            {
+                mSlots[ slot ] = hash;
+                mSize ++;
+                return;
+            }
+        }
+    }
+
+    bool PositionHistory::Contains( uint64_t hash ) const
+    {
+        if ( hash == 0 )
+        {
+            return mHasZero;
+        }
+
+        size_t mask = mSlots.size() - 1;
+        for ( size_t slot = hash & mask; mSlots[ slot ] != 0; slot = ( slot + 1 ) & mask )
+        {
+            if ( mSlots[ slot ] == hash )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void PositionHistory::Grow()
+    {
+        std::vector< uint64_t > slots( mSlots.size() * 2, 0 );
+        slots.swap( mSlots );
+
+        size_t mask = mSlots.size() - 1;
+        for ( uint64_t hash : slots )
+        {
+            if ( hash == 0 )
+            {
+                continue;
+            }
+
+            size_t slot = hash & mask;
+            while ( mSlots[ slot ] != 0 )
+            {
+                slot = ( slot + 1 ) & mask;
+            }
+            mSlots[ slot ] = hash;
+        }
+    }
+
+} // namespace go
@@ -0,0 +1,47 @@
+#ifndef __GO_POSITION_HISTORY_H__
+#define __GO_POSITION_HISTORY_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace go {
+
+    // Set of position hashes seen in a game, as an open addressing table
+    // of bare 64 bit keys with linear probing. A game inserts a few hundred
+    // keys, so the table stays small and lookups touch one or two cache
+    // lines.
+
+    class PositionHistory
+    {
+    public:
+        void
+        Insert( uint64_t hash );
+
+        bool
+        Contains( uint64_t hash ) const;
+
+        size_t
+        GetSize() const { return mSize; }
+
+        void
+        Clear();
+
+    public:
+        PositionHistory();
+        ~PositionHistory();
+
+    private:
+        void
+        Grow();
+
+    private:
+        // Zero marks a free slot, so a zero hash is stored out of the table
+        std::vector< uint64_t > mSlots;
+        size_t                  mSize;
+        bool                    mHasZero;
+    };
+
+} // namespace go
+
+#endif // __GO_POSITION_HISTORY_H__
@@ -0,0 +1,293 @@
+#include "cmn/trace.h"
+#include "go/board.h"
+#include "go/scorer.h"
+
+#include <algorithm>
+
+namespace go {
+
+    static const unsigned kNone = static_cast< unsigned >( -1 );
+
+    Scorer::Scorer( float komi /* = 0.0f */, ScoringMode mode /* = SCORING_MODE_UNCONDITIONAL */ )
+        : mKomi( komi )
+        , mMode( mode )
+        , mSize( 0 )
+    {
+    }
+
+    Scorer::~Scorer()
+    {
+    }
+
+    unsigned Scorer::GetNeighbours( unsigned point, unsigned * neighbours ) const
+    {
+        unsigned row    = point / mSize;
+        unsigned column = point % mSize;
+
+        unsigned count = 0;
+        if ( row > 0 )              neighbours[ count ++ ] = point - mSize;
+        if ( row + 1 < mSize )      neighbours[ count ++ ] = point + mSize;
+        if ( column > 0 )           neighbours[ count ++ ] = point - 1;
+        if ( column + 1 < mSize )   neighbours[ count ++ ] = point + 1;
+        return count;
+    }
+
+    unsigned Scorer::Label( std::vector< unsigned > & labels, Cell match, bool inverse )
+    {
+        // Numbers the connected groups of points that are ( or, if inverse,
+        // are not ) of the given cell; other points get kNone
+
+        unsigned pointCount = mSize * mSize;
+        labels.assign( pointCount, kNone );
+
+        unsigned count = 0;
+        for ( unsigned point = 0; point < pointCount; ++ point )
+        {
+            if ( labels[ point ] != kNone || ( ( mCells[ point ] == match ) == inverse ) )
+            {
+                continue;
+            }
+
+            labels[ point ] = count;
+            mStack.clear();
+            mStack.push_back( point );
+            while ( !mStack.empty() )
+            {
+                unsigned current = mStack.back();
+                mStack.pop_back();
+
+                unsigned neighbours[4];
+                unsigned neighbourCount = GetNeighbours( current, neighbours );
+                for ( unsigned i = 0; i < neighbourCount; ++ i )
+                {
+                    unsigned neighbour = neighbours[i];
+                    if ( labels[ neighbour ] == kNone && ( ( mCells[ neighbour ] == match ) != inverse ) )
+                    {
+                        labels[ neighbour ] = count;
+                        mStack.push_back( neighbour );
+                    }
+                }
+            }
+            count ++;
+        }
+
+        return count;
+    }
+
+    void Scorer::RemoveDeadStones( Cell color )
+    {
+        unsigned pointCount     = mSize * mSize;
+        unsigned chainCount     = Label( mChains, color, false );
+        unsigned regionCount    = Label( mRegions, color, true );
+
+        // Chains around each region, and whether the region is vital to
+        // them, i.e. each of its empty points is a liberty of the chain
+
+        std::vector< std::vector< unsigned > > regionChains( regionCount );
+        std::vector< std::vector< bool > > regionVital( regionCount );
+
+        for ( unsigned point = 0; point < pointCount; ++ point )
+        {
+            unsigned region = mRegions[ point ];
+            if ( region == kNone )
+            {
+                continue;
+            }
+
+            unsigned neighbours[4];
+            unsigned neighbourCount = GetNeighbours( point, neighbours );
+            for ( unsigned i = 0; i < neighbourCount; ++ i )
+            {
+                unsigned chain = mChains[ neighbours[i] ];
+                std::vector< unsigned > & chains = regionChains[ region ];
+                if ( chain != kNone && std::find( chains.begin(), chains.end(), chain ) == chains.end() )
+                {
+                    chains.push_back( chain );
+                }
+            }
+        }
+
+        for ( unsigned region = 0; region < regionCount; ++ region )
+        {
+            regionVital[ region ].assign( regionChains[ region ].size(), true );
+        }
+
+        for ( unsigned point = 0; point < pointCount; ++ point )
+        {
+            unsigned region = mRegions[ point ];
+            if ( region == kNone || mCells[ point ] != CELL_EMPTY )
+            {
+                continue;
+            }
+
+            unsigned neighbours[4];
+            unsigned neighbourCount = GetNeighbours( point, neighbours );
+            std::vector< unsigned > & chains = regionChains[ region ];
+            for ( size_t c = 0; c < chains.size(); ++ c )
+            {
+                bool liberty = false;
+                for ( unsigned i = 0; i < neighbourCount; ++ i )
+                {
+                    liberty = liberty || ( mChains[ neighbours[i] ] == chains[c] );
+                }
+                if ( !liberty )
+                {
+                    regionVital[ region ][c] = false;
+                }
+            }
+        }
+
+        // Benson's iteration
+
+        std::vector< bool > chainAlive( chainCount, true );
+        std::vector< bool > regionAlive( regionCount, true );
+        std::vector< unsigned > vitalCount( chainCount );
+
+        bool changed = true;
+        while ( changed )
+        {
+            changed = false;
+
+            std::fill( vitalCount.begin(), vitalCount.end(), 0 );
+            for ( unsigned region = 0; region < regionCount; ++ region )
+            {
+                if ( !regionAlive[ region ] )
+                {
+                    continue;
+                }
+                for ( size_t c = 0; c < regionChains[ region ].size(); ++ c )
+                {
+                    if ( regionVital[ region ][c] )
+                    {
+                        vitalCount[ regionChains[ region ][c] ] ++;
+                    }
+                }
+            }
+
+            for ( unsigned chain = 0; chain < chainCount; ++ chain )
+            {
+                if ( chainAlive[ chain ] && vitalCount[ chain ] < 2 )
+                {
+                    chainAlive[ chain ] = false;
+                    changed = true;
+                }
+            }
+
+            for ( unsigned region = 0; region < regionCount; ++ region )
+            {
+                if ( !regionAlive[ region ] )
+                {
+                    continue;
+                }
+                for ( unsigned chain : regionChains[ region ] )
+                {
+                    if ( !chainAlive[ chain ] )
+                    {
+                        regionAlive[ region ] = false;
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Opponent stones in a region vital to an alive chain are dead
+
+        std::vector< bool > regionSafe( regionCount, false );
+        for ( unsigned region = 0; region < regionCount; ++ region )
+        {
+            if ( regionAlive[ region ] )
+            {
+                for ( size_t c = 0; c < regionChains[ region ].size(); ++ c )
+                {
+                    regionSafe[ region ] = regionSafe[ region ] || regionVital[ region ][c];
+                }
+            }
+        }
+
+        for ( unsigned point = 0; point < pointCount; ++ point )
+        {
+            unsigned region = mRegions[ point ];
+            if ( region != kNone && regionSafe[ region ] )
+            {
+                mCells[ point ] = CELL_EMPTY;
+            }
+        }
+    }
+
+    float Scorer::GetScore( const Board & board, Color color )
+    {
+        mSize = board.GetSize();
+        unsigned pointCount = mSize * mSize;
+
+        mCells.resize( pointCount );
+        for ( unsigned point = 0; point < pointCount; ++ point )
+        {
+            mCells[ point ] = board( point / mSize, point % mSize );
+        }
+
+        if ( mMode == SCORING_MODE_UNCONDITIONAL )
+        {
+            // Both colors are judged on the original position
+            std::vector< Cell > cells = mCells;
+            RemoveDeadStones( CELL_BLACK );
+            std::vector< Cell > blackResolved = mCells;
+            mCells = cells;
+            RemoveDeadStones( CELL_WHITE );
+            for ( unsigned point = 0; point < pointCount; ++ point )
+            {
+                if ( blackResolved[ point ] == CELL_EMPTY )
+                {
+                    mCells[ point ] = CELL_EMPTY;
+                }
+            }
+        }
+
+        // Area count: stones, and empty regions reaching one color only
+
+        int black = 0;
+        int white = 0;
+        for ( unsigned point = 0; point < pointCount; ++ point )
+        {
+            black += ( mCells[ point ] == CELL_BLACK );
+            white += ( mCells[ point ] == CELL_WHITE );
+        }
+
+        unsigned regionCount = Label( mRegions, CELL_EMPTY, false );
+        std::vector< unsigned > regionSize( regionCount, 0 );
+        std::vector< unsigned > regionBorders( regionCount, 0 );
+        for ( unsigned point = 0; point < pointCount; ++ point )
+        {
+            unsigned region = mRegions[ point ];
+            if ( region == kNone )
+            {
+                continue;
+            }
+
+            regionSize[ region ] ++;
+
+            unsigned neighbours[4];
+            unsigned neighbourCount = GetNeighbours( point, neighbours );
+            for ( unsigned i = 0; i < neighbourCount; ++ i )
+            {
+                regionBorders[ region ] |= mCells[ neighbours[i] ];
+            }
+        }
+
+        for ( unsigned region = 0; region < regionCount; ++ region )
+        {
+            if ( regionBorders[ region ] == CELL_BLACK )
+            {
+                black += regionSize[ region ];
+            }
+            else if ( regionBorders[ region ] == CELL_WHITE )
+            {
+                white += regionSize[ region ];
+            }
+        }
+
+        float score = static_cast< float >( white - black ) + mKomi;
+        return ( color == COLOR_WHITE ) ? score : -score;
+    }
+
+} // namespace go
@@ -0,0 +1,72 @@
+#ifndef __GO_SCORER_H__
+#define __GO_SCORER_H__
+
+#include "go/cell.h"
+#include "go/color.h"
+#include <vector>
+
+namespace go {
+
+    class Board;
+
+    enum ScoringMode
+    {
+        // Every stone on the board is taken as alive
+        SCORING_MODE_FAST = 1,
+
+        // Stones inside the opponent's unconditionally alive area are taken
+        // as dead first
+        SCORING_MODE_UNCONDITIONAL,
+    };
+
+    // Area scoring of a final position: stones plus empty regions bordered
+    // by one color only, and komi for white.
+    //
+    // Unconditional life is decided the way Benson's algorithm does it, as
+    // in GNU Go's engine/unconditional.c: strings are dropped until every
+    // remaining one has two regions all of whose empty points are its
+    // liberties, and all the strings around those regions remain. Such
+    // strings live whatever the opponent plays, and opponent stones in
+    // their vital regions can't be saved.
+
+    class Scorer
+    {
+    public:
+        // Score margin of the color, positive if it wins
+        float
+        GetScore( const Board &, Color );
+
+        void
+        SetKomi( float komi ) { mKomi = komi; }
+
+        void
+        SetMode( ScoringMode mode ) { mMode = mode; }
+
+    public:
+        Scorer( float komi = 0.0f, ScoringMode mode = SCORING_MODE_UNCONDITIONAL );
+        ~Scorer();
+
+    private:
+        unsigned
+        GetNeighbours( unsigned point, unsigned * neighbours ) const;
+
+        unsigned
+        Label( std::vector< unsigned > & labels, Cell match, bool inverse );
+
+        void
+        RemoveDeadStones( Cell color );
+
+    private:
+        float                       mKomi;
+        ScoringMode                 mMode;
+
+        unsigned                    mSize;
+        std::vector< Cell >         mCells;
+        std::vector< unsigned >     mChains;
+        std::vector< unsigned >     mRegions;
+        std::vector< unsigned >     mStack;
+    };
+
+} // namespace go
+
+#endif // __GO_SCORER_H__
@@ -0,0 +1,30 @@
+#include "cmn/trace.h"
+#include "go/symmetry.h"
+
+namespace go {
+
+    unsigned TransformPoint( unsigned symmetry, unsigned point, unsigned boardSize )
+    {
+        CMN_ASSERT( symmetry < kSymmetryCount );
+        CMN_ASSERT( point < boardSize * boardSize );
+
+        unsigned last   = boardSize - 1;
+        unsigned row    = point / boardSize;
+        unsigned column = point % boardSize;
+
+        if ( symmetry & 4 )
+        {
+            column = last - column;
+        }
+
+        for ( unsigned turn = 0; turn < ( symmetry & 3 ); ++ turn )
+        {
+            unsigned rotatedRow = column;
+            column  = last - row;
+            row     = rotatedRow;
+        }
+
+        return row * boardSize + column;
+    }
+
+} // namespace go
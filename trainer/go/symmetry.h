@@ -0,0 +1,18 @@
+#ifndef __GO_SYMMETRY_H__
+#define __GO_SYMMETRY_H__
+
+namespace go {
+
+    // The 8 symmetries of a square board: symmetries 0 to 3 rotate the
+    // board by a quarter turn each, 4 to 7 mirror it left to right first.
+    // Symmetry 0 is the identity.
+
+    const unsigned kSymmetryCount = 8;
+
+    // Where the point row * boardSize + column goes under the symmetry
+    unsigned
+    TransformPoint( unsigned symmetry, unsigned point, unsigned boardSize );
+
+} // namespace go
+
+#endif // __GO_SYMMETRY_H__
@@ -39,4 +39,55 @@ namespace go {
         return ( color == COLOR_BLACK ) ? CELL_BLACK : CELL_WHITE;
     }
 
+    void EncodeBoard( const Board & board, Color color, std::vector< double > & inputs )
+    {
+        unsigned size = board.GetSize();
+        inputs.resize( size * size );
+
+        Cell own = CellFromColor( color );
+        for ( unsigned row = 0; row < size; ++ row )
+        {
+            double * rowInputs = &inputs[ row * size ];
+            for ( unsigned column = 0; column < size; ++ column )
+            {
+                Cell cell = board( row, column );
+                rowInputs[ column ] = ( cell == CELL_EMPTY ) ? 0.0 : ( cell == own ) ? 1.0 : -1.0;
+            }
+        }
+    }
+
+    unsigned FindBestMove( const std::vector< double > & ratings, const std::vector< bool > & legalMoves )
+    {
+        CMN_ASSERT( ratings.size() == legalMoves.size() );
+
+        unsigned pass = static_cast< unsigned >( legalMoves.size() - 1 );
+        unsigned best = pass;
+        for ( unsigned index = 0; index < pass; ++ index )
+        {
+            if ( legalMoves[ index ] && ratings[ index ] > ratings[ best ] )
+            {
+                best = index;
+            }
+        }
+        return best;
+    }
+
+    Move MoveFromIndex( unsigned index, unsigned boardSize )
+    {
+        Move retval;
+
+        if ( index == boardSize * boardSize )
+        {
+            retval.type = MOVE_TYPE_PASS;
+        }
+        else
+        {
+            retval.type   = MOVE_TYPE_PLACE;
+            retval.row    = index / boardSize;
+            retval.column = index % boardSize;
+        }
+
+        return retval;
+    }
+
 } // namespace go
@@ -5,6 +5,8 @@
 #include "go/color.h"
 #include "go/move.h"
 
+#include <vector>
+
 namespace go {
 
     class Board;
@@ -18,6 +20,19 @@ namespace go {
     Cell
     CellFromColor( Color );
 
+    // Network inputs of the player of the given color, one per point: 1
+    // for its stones, -1 for the opponent's and 0 for empty points
+    void
+    EncodeBoard( const Board &, Color, std::vector< double > & inputs );
+
+    // Index of the legal move rated best, in the layout of
+    // Board::GetLegalMoves(); passing is always legal
+    unsigned
+    FindBestMove( const std::vector< double > & ratings, const std::vector< bool > & legalMoves );
+
+    Move
+    MoveFromIndex( unsigned index, unsigned boardSize );
+
 } // namespace go
 
 #endif // __GO_UTILS_H__
@@ -0,0 +1,64 @@
+#include "cmn/trace.h"
+#include "go/zobrist.h"
+
+namespace go {
+
+    namespace {
+
+        struct ZobristKeys
+        {
+            uint64_t    stones[ kZobristMaxPoints ][2];
+            uint64_t    ko[ kZobristMaxPoints ];
+            uint64_t    whiteToMove;
+
+            ZobristKeys()
+            {
+                // splitmix64 from a fixed seed
+                uint64_t state = 0x5a0b1c2d3e4f6071ull;
+                auto next = [ &state ] () {
+                    uint64_t z = ( state += 0x9e3779b97f4a7c15ull );
+                    z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+                    z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebull;
+                    return z ^ ( z >> 31 );
+                };
+
+                for ( unsigned point = 0; point < kZobristMaxPoints; ++ point )
+                {
+                    stones[ point ][0]  = next();
+                    stones[ point ][1]  = next();
+                    ko[ point ]         = next();
+                }
+                whiteToMove = next();
+            }
+        };
+
+        const ZobristKeys sKeys;
+
+    } // namespace
+
+    uint64_t ZobristStoneKey( unsigned point, Cell cell )
+    {
+        CMN_ASSERT( point < kZobristMaxPoints );
+        switch ( cell )
+        {
+        case CELL_BLACK:
+            return sKeys.stones[ point ][0];
+        case CELL_WHITE:
+            return sKeys.stones[ point ][1];
+        default:
+            return 0;
+        }
+    }
+
+    uint64_t ZobristKoKey( unsigned point )
+    {
+        CMN_ASSERT( point < kZobristMaxPoints );
+        return sKeys.ko[ point ];
+    }
+
+    uint64_t ZobristWhiteToMoveKey()
+    {
+        return sKeys.whiteToMove;
+    }
+
+} // namespace go
@@ -0,0 +1,26 @@
+#ifndef __GO_ZOBRIST_H__
+#define __GO_ZOBRIST_H__
+
+#include "go/cell.h"
+#include <cstdint>
+
+namespace go {
+
+    // Random keys for Zobrist hashing of positions: a position's hash is
+    // the xor of the keys of its stones, so it is updated with one xor per
+    // placed or removed stone. The keys are fixed, hashes can be stored.
+
+    const unsigned kZobristMaxPoints = 19 * 19;
+
+    uint64_t
+    ZobristStoneKey( unsigned point, Cell );
+
+    uint64_t
+    ZobristKoKey( unsigned point );
+
+    uint64_t
+    ZobristWhiteToMoveKey();
+
+} // namespace go
+
+#endif // __GO_ZOBRIST_H__
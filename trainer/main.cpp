@@ -1,54 +1,314 @@
+#include "cmn/profile.h"
+#include "cmn/thread_pool.h"
 #include "cmn/trace.h"
+#include "ann/perceptron_evolution_strategies_trainer.h"
 #include "ann/perceptron_genetic_algorithm_trainer.h"
+#include "boost/archive/binary_iarchive.hpp"
 #include "boost/archive/binary_oarchive.hpp"
+#include "boost/serialization/string.hpp"
 #include "boost/serialization/vector.hpp"
-#include "gnugo/engine.h"
-#include "gnugo/game.h"
-#include "gnugo/player.h"
-#include "gnugo/player_ann.h"
-#include "gnugo/player_random.h"
+#include "gnugo/engine_pool.h"
+#include "gnugo/reply_cache.h"
+#include "training/checkpointer.h"
+#include "training/fitness_cache.h"
+#include "training/fitness_scheduler.h"
+#include "training/game_recorder.h"
+#include "training/generation_evaluator.h"
+#include "training/player_network.h"
+#include "training/tournament.h"
 
-#include <fstream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
 
 const unsigned kBoardSize       = 9;
 const unsigned kCellCount       = kBoardSize * kBoardSize;
 const unsigned kPopulationSize  = 10;
 const unsigned kGameCount       = 50;
+const unsigned kLevel           = 1;
+
+// GNU Go restarts every game from a seed of its own, kSeed + game, so that
+// the games of an evaluation differ while its replies depend on the game
+// and the position only, and are cached
+const unsigned kSeed            = 1;
+
+// GNU Go linked into the trainer, one engine per thread, rather than one
+// process per engine spoken to over GTP
+const bool kNativeEngine        = true;
+
+// Moves of the concurrent games of a network computed in one forward pass;
+// zero, the default, computes each move on its own. Opt-in: a move waits
+// for its batch, which pays only when batched inference is much cheaper
+// than row by row.
+const unsigned kInferenceBatchSize = 0;
+
+// Fitness: games against GNU Go, or a round robin league between the
+// networks of the generation, kLeagueGamesPerPair games a pair, the
+// fitness being minus the Elo gain. League ratings only compare a
+// generation with itself, so there is no target and training goes on
+// until stopped.
+const bool kLeague              = false;
+const unsigned kLeagueGamesPerPair = 2;
+
+// Search: the genetic algorithm, or natural evolution strategies with
+// kPopulationSize / 2 pairs of mirrored samples
+const bool kEvolutionStrategies = false;
+
+// Games are raced in rounds of this many, individuals that can't make the
+// elite stopping early; zero plays all kGameCount games of everyone. The
+// evolution strategies rank every sample, so they don't race.
+const unsigned kRoundGameCount  = 5;
+
+// Fitness of networks seen before, for elites and children mutation left
+// unchanged, once they have played all the games; zero evaluates everything
+const unsigned kFitnessCacheSize = 10000;
+
+// The caches grow large and are only ever a head start, so they are saved
+// every this many generations rather than after each one
+const unsigned kCacheSnapshotInterval = 10;
+
+static gnugo::EnginePool            sEnginePool;
+static Cmn::ThreadPool              sThreadPool;
+static training::FitnessScheduler   sFitnessScheduler( sThreadPool );
+static training::GameRecorder       sGameRecorder( "games.rec" );
+static training::FitnessCache       sFitnessCache( kFitnessCacheSize );
+static gnugo::ReplyCache            sReplyCache;
+
+training::GenerationEvaluator::Settings GetEvaluatorSettings()
+{
+    training::GenerationEvaluator::Settings settings;
+    settings.boardSize          = kBoardSize;
+    settings.level              = kLevel;
+    settings.gameCount          = kGameCount;
+    settings.roundGameCount     = kRoundGameCount;
+    settings.seed               = kSeed;
+    settings.nativeEngine       = kNativeEngine;
+    settings.inferenceBatchSize = kInferenceBatchSize;
+    return settings;
+}
+
+static training::GenerationEvaluator sEvaluator( GetEvaluatorSettings(), sFitnessScheduler, sEnginePool, sReplyCache );
 
 double FitnessOp( ANN::ConstPerceptronIn nw )
 {
-    double fitness = 0.0;
+    // A single individual; generations go through GenerationFitnessOp()
+    std::vector< double > fitness;
+    sFitnessScheduler.Evaluate( 1, kGameCount,
+        [ &nw ] ( unsigned, unsigned game ) { return sEvaluator.PlayGame( nw, game ); },
+        fitness );
+
+    return fitness[0];
+}
+
+// Races for the eliteCount fittest; zero plays every game of everyone
+void GenerationFitnessOp( const std::vector< ANN::ConstPerceptronRef > & generation, unsigned eliteCount,
+                          std::vector< double > & fitness )
+{
+    unsigned gameCount = sEvaluator.Evaluate( generation, eliteCount, fitness );
+    CMN_MSG( "%u of %u games played", gameCount, static_cast< unsigned >( generation.size() ) * kGameCount );
+}
+
+void LeagueFitnessOp( const std::vector< ANN::ConstPerceptronRef > & generation, std::vector< double > & fitness )
+{
+    unsigned memberCount = static_cast< unsigned >( generation.size() );
+    training::Tournament tournament( memberCount, kBoardSize, sThreadPool );
+    tournament.PlayRoundRobin(
+        [ &generation ] ( unsigned member, unsigned ) {
+            return std::unique_ptr< go::IPlayer >( new training::PlayerNetwork( generation[ member ] ) );
+        },
+        kLeagueGamesPerPair );
+
+    // Elo is zero sum, the mean rating is the initial one
+    const std::vector< double > & ratings = tournament.GetRatings();
+    double meanRating = std::accumulate( ratings.begin(), ratings.end(), 0.0 ) / memberCount;
+
+    fitness.resize( memberCount );
+    for ( unsigned member = 0; member < memberCount; ++ member )
+    {
+        fitness[ member ] = meanRating - ratings[ member ];
+    }
+}
+
+std::string MakeFitnessCacheSnapshot()
+{
+    std::ostringstream stream( std::ios::out | std::ios::binary );
+    sFitnessCache.Save( stream );
+    return stream.str();
+}
+
+std::string MakeReplyCacheSnapshot()
+{
+    std::ostringstream stream( std::ios::out | std::ios::binary );
+    sReplyCache.Save( stream );
+    return stream.str();
+}
+
+// Trainer checkpoint: format version, generation counter, best fitness
+// and the trainer's population, in a single file so that what the search
+// resumes from always belongs to one generation. The caches are saved on
+// their own; their entries hold for any generation, so a cache file older
+// or newer than the checkpoint is merely less useful.
+
+const unsigned kCheckpointVersion = 2;
+
+std::string MakeCheckpoint( unsigned generation, double fitness, const ANN::IPerceptronTrainer & trainer )
+{
+    std::ostringstream population( std::ios::out | std::ios::binary );
+    trainer.Save( population );
 
-    #pragma omp parallel
-    #pragma omp for
-    for ( int i = 0; i < kGameCount; ++ i )
+    std::ostringstream stream( std::ios::out | std::ios::binary );
     {
-        gnugo::Engine       engine( 1, kBoardSize );
-        gnugo::PlayerAnn    blackPlayer( nw, engine );
-        gnugo::Player       whitePlayer( engine );
-        gnugo::Game         game( kBoardSize, blackPlayer, whitePlayer, engine );
-        game.Play();
+        boost::archive::binary_oarchive archive( stream );
+        archive << kCheckpointVersion << generation << fitness << population.str();
+    }
+    return stream.str();
+}
 
-        fitness += engine.GetScore( go::COLOR_WHITE );
+bool LoadCheckpoint( const std::string & snapshot, unsigned & generation, double & fitness, ANN::IPerceptronTrainer & trainer )
+{
+    unsigned version = 0;
+    std::string population;
+    try
+    {
+        std::istringstream stream( snapshot, std::ios::in | std::ios::binary );
+        boost::archive::binary_iarchive archive( stream );
+        archive >> version;
+        if ( version != kCheckpointVersion )
+        {
+            return false;
+        }
+        archive >> generation >> fitness >> population;
     }
+    catch ( const boost::archive::archive_exception & )
+    {
+        return false;
+    }
+
+    std::istringstream stream( population, std::ios::in | std::ios::binary );
+    return trainer.Load( stream );
+}
 
-    return fitness / kGameCount;
+std::string MakeNetworkSnapshot( ANN::ConstPerceptronIn network )
+{
+    std::ostringstream stream( std::ios::out | std::ios::binary );
+    {
+        boost::archive::binary_oarchive archive( stream );
+        archive << *network;
+    }
+    return stream.str();
 }
 
 int main( int argc, char * argv[] )
 {
-    ANN::IPerceptronGeneticAlgorithmTrainerRef trainer =
-        ANN::CreatePerceptronGeneticAlgorithmTrainer( FitnessOp, kCellCount, kCellCount + 1, kPopulationSize );
-    trainer->SetMutationProbability( 0.001f );
-    trainer->SetMutationSpeed( 0.3f );
+    // Worker threads log through the trace thread
+    Cmn::AsyncTrace asyncTrace;
+
+    sEvaluator.SetFitnessCache( &sFitnessCache );
+    sEvaluator.SetGameRecorder( &sGameRecorder );
+
+    ANN::IPerceptronTrainerRef trainer;
+    unsigned eliteCount = 0;
+    if ( kEvolutionStrategies )
+    {
+        ANN::IPerceptronEvolutionStrategiesTrainerRef strategies =
+            ANN::CreatePerceptronEvolutionStrategiesTrainer( FitnessOp, kCellCount, kCellCount + 1, kPopulationSize / 2, sThreadPool );
+        strategies->SetLearningRate( 0.01f );
+        strategies->SetNoiseDeviation( 0.02f );
+        trainer = strategies;
+    }
+    else
+    {
+        ANN::IPerceptronGeneticAlgorithmTrainerRef geneticAlgorithm =
+            ANN::CreatePerceptronGeneticAlgorithmTrainer( FitnessOp, kCellCount, kCellCount + 1, kPopulationSize, sThreadPool );
+        geneticAlgorithm->SetMutationProbability( 0.001f );
+        geneticAlgorithm->SetMutationSpeed( 0.3f );
+        eliteCount = geneticAlgorithm->GetEliteCount();
+        trainer = geneticAlgorithm;
+    }
+
+    if ( kLeague )
+    {
+        trainer->SetGenerationFitnessOp( LeagueFitnessOp );
+    }
+    else
+    {
+        trainer->SetGenerationFitnessOp(
+            [ eliteCount ] ( const std::vector< ANN::ConstPerceptronRef > & generation, std::vector< double > & fitness ) {
+                GenerationFitnessOp( generation, eliteCount, fitness );
+            } );
+    }
+
+    // fittest.nw is the fittest network on its own, for other tools
+    training::Checkpointer checkpointer( "trainer.ckpt" );
+    training::Checkpointer fittestCheckpointer( "fittest.nw" );
+    training::Checkpointer fitnessCacheCheckpointer( "fitness.cache" );
+    training::Checkpointer replyCacheCheckpointer( "replies.cache" );
+
+    unsigned generation = 0;
+    std::string snapshot;
+    if ( checkpointer.Load( snapshot ) )
+    {
+        double fitness = 0.0;
+        if ( LoadCheckpoint( snapshot, generation, fitness, *trainer ) )
+        {
+            CMN_MSG( "Resuming at generation %u, fitness %3.3f", generation, fitness );
+        }
+        else
+        {
+            generation = 0;
+            CMN_ERR( "Ignoring %s, starting from a new population", checkpointer.GetPath().c_str() );
+        }
+    }
+
+    if ( fitnessCacheCheckpointer.Load( snapshot ) )
+    {
+        std::istringstream stream( snapshot, std::ios::in | std::ios::binary );
+        if ( !sFitnessCache.Load( stream ) )
+        {
+            CMN_ERR( "Ignoring the rest of %s", fitnessCacheCheckpointer.GetPath().c_str() );
+        }
+    }
+
+    if ( replyCacheCheckpointer.Load( snapshot ) )
+    {
+        std::istringstream stream( snapshot, std::ios::in | std::ios::binary );
+        if ( !sReplyCache.Load( stream ) )
+        {
+            CMN_ERR( "Ignoring the rest of %s", replyCacheCheckpointer.GetPath().c_str() );
+        }
+    }
 
     double fitness = 0.0;
     do {
-        fitness = trainer->Step();
+        {
+            CMN_PROFILE_SCOPE( "trainer.step" );
+            fitness = trainer->Step();
+        }
+        generation ++;
         CMN_MSG( "%3.3f", fitness );
+    #if CMN_PROFILE
+        CMN_MSG( "%s", Cmn::ProfileReport( true ).c_str() );
+    #endif
+
+        // Snapshots are serialised here, on the training thread, and only
+        // the disk writes happen in the background
+        checkpointer.Save( MakeCheckpoint( generation, fitness, *trainer ) );
+        fittestCheckpointer.Save( MakeNetworkSnapshot( trainer->GetFittest() ) );
+        if ( generation % kCacheSnapshotInterval == 0 )
+        {
+            fitnessCacheCheckpointer.Save( MakeFitnessCacheSnapshot() );
+            replyCacheCheckpointer.Save( MakeReplyCacheSnapshot() );
+        }
+    } while ( kLeague || fitness > -70.0 );
+
+    fitnessCacheCheckpointer.Save( MakeFitnessCacheSnapshot() );
+    replyCacheCheckpointer.Save( MakeReplyCacheSnapshot() );
 
-        std::ofstream fittestOutputStream( "fittest.nw", std::ios::out | std::ios::trunc );
-        boost::archive::binary_oarchive fittestOutputArchive( fittestOutputStream );
-        fittestOutputArchive << *trainer->GetFittest();
-    } while ( fitness > -70.0 );
+    checkpointer.Wait();
+    fittestCheckpointer.Wait();
+    fitnessCacheCheckpointer.Wait();
+    replyCacheCheckpointer.Wait();
+    sGameRecorder.Flush();
 }
@@ -0,0 +1,312 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "ann/perceptron.h"
+#include "ann/perceptron_evolution_strategies_trainer.h"
+#include "ann/perceptron_genetic_algorithm_trainer.h"
+#include "cmn/thread_pool.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <vector>
+
+TEST( Perceptron, Compute )
+{
+    // Two outputs of three inputs: weights then bias, output after output
+    const double kWeights[] = {
+         0.5, -1.0,  0.25,  0.1,
+        -0.5,  2.0,  0.0,  -0.3,
+    };
+    ANN::Perceptron perceptron( 3, 2, kWeights );
+
+    std::vector< double > inputs = { 1.0, 0.5, -2.0 };
+    std::vector< double > outputs = perceptron.Compute( inputs );
+
+    ASSERT_EQ( outputs.size(), 2u );
+    EXPECT_DOUBLE_EQ( outputs[0], std::tanh( 0.5 - 0.5 - 0.5 + 0.1 ) );
+    EXPECT_DOUBLE_EQ( outputs[1], std::tanh( -0.5 + 1.0 + 0.0 - 0.3 ) );
+}
+
+TEST( Perceptron, ComputeBatch )
+{
+    const unsigned kInputsCount = 81;
+    const unsigned kOutputsCount = 82;
+    const unsigned kRowCount = 21;
+
+    std::default_random_engine random( 1 );
+    std::uniform_real_distribution< double > distribution( -1.0, 1.0 );
+
+    std::vector< double > weights( ANN::Perceptron::GetWeightsCount( kInputsCount, kOutputsCount ) );
+    for ( double & weight : weights )
+    {
+        weight = distribution( random );
+    }
+    ANN::Perceptron perceptron( kInputsCount, kOutputsCount, weights.data() );
+
+    std::vector< double > inputs( kRowCount * kInputsCount );
+    for ( double & input : inputs )
+    {
+        input = distribution( random );
+    }
+
+    std::vector< double > outputs;
+    perceptron.ComputeBatch( inputs, kRowCount, outputs );
+    ASSERT_EQ( outputs.size(), kRowCount * kOutputsCount );
+
+    for ( unsigned row = 0; row < kRowCount; ++ row )
+    {
+        std::vector< double > rowInputs( inputs.begin() + row * kInputsCount, inputs.begin() + ( row + 1 ) * kInputsCount );
+        std::vector< double > rowOutputs = perceptron.Compute( rowInputs );
+        for ( unsigned output = 0; output < kOutputsCount; ++ output )
+        {
+            EXPECT_DOUBLE_EQ( rowOutputs[ output ], outputs[ row * kOutputsCount + output ] );
+        }
+    }
+}
+
+static double TargetFitnessOp( ANN::ConstPerceptronIn nw )
+{
+    // Distance of the outputs to a target, for a fixed input
+    std::vector< double > outputs = nw->Compute( std::vector< double >( nw->GetInputsCount(), 0.5 ) );
+    double distance = 0.0;
+    for ( unsigned i = 0; i < outputs.size(); ++ i )
+    {
+        double error = outputs[i] - ( ( i & 1 ) ? 0.5 : -0.5 );
+        distance += error * error;
+    }
+    return distance;
+}
+
+TEST( PerceptronGeneticAlgorithmTrainer, Converges )
+{
+    const unsigned kPopulationSize = 40;
+    const unsigned kGenerationCount = 50;
+
+    Cmn::ThreadPool pool( 4 );
+    ANN::IPerceptronGeneticAlgorithmTrainerRef trainer =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( TargetFitnessOp, 8, 4, kPopulationSize, pool, 1 );
+    trainer->SetMutationProbability( 0.05f );
+    trainer->SetMutationSpeed( 0.1f );
+
+    double first = trainer->Step();
+    double fitness = first;
+    for ( unsigned generation = 1; generation < kGenerationCount; ++ generation )
+    {
+        double next = trainer->Step();
+
+        // The elites are kept and the fitness op is deterministic
+        EXPECT_LE( next, fitness );
+        fitness = next;
+    }
+
+    EXPECT_LT( fitness, first * 0.1 );
+    EXPECT_DOUBLE_EQ( TargetFitnessOp( trainer->GetFittest() ), fitness );
+}
+
+TEST( PerceptronGeneticAlgorithmTrainer, Deterministic )
+{
+    // The same seed breeds the same population, however the chunks of
+    // children are spread over threads
+    Cmn::ThreadPool pool( 4 );
+    Cmn::ThreadPool singleThreadPool( 1 );
+    ANN::IPerceptronGeneticAlgorithmTrainerRef first =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( TargetFitnessOp, 8, 4, 50, pool, 7 );
+    ANN::IPerceptronGeneticAlgorithmTrainerRef second =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( TargetFitnessOp, 8, 4, 50, singleThreadPool, 7 );
+
+    for ( unsigned generation = 0; generation < 10; ++ generation )
+    {
+        EXPECT_EQ( first->Step(), second->Step() );
+    }
+    EXPECT_EQ( first->GetFittest()->GetWeights(), second->GetFittest()->GetWeights() );
+}
+
+// Genomes of a saved trainer, one row per individual
+static std::vector< std::vector< double > > GetPopulation( const ANN::IPerceptronGeneticAlgorithmTrainer & trainer )
+{
+    std::stringstream stream;
+    trainer.Save( stream );
+
+    uint32_t shape[2] = { 0, 0 };
+    uint64_t seedAndGeneration[2] = { 0, 0 };
+    stream.read( reinterpret_cast< char * >( shape ), sizeof( shape ) );
+    stream.read( reinterpret_cast< char * >( seedAndGeneration ), sizeof( seedAndGeneration ) );
+
+    std::vector< std::vector< double > > population( shape[0], std::vector< double >( shape[1] ) );
+    for ( auto & genome : population )
+    {
+        stream.read( reinterpret_cast< char * >( genome.data() ), genome.size() * sizeof( double ) );
+    }
+    EXPECT_TRUE( !!stream );
+    return population;
+}
+
+TEST( PerceptronGeneticAlgorithmTrainer, Crossover )
+{
+    // Without mutation every weight of a child is the weight of a parent,
+    // bit for bit
+    Cmn::ThreadPool pool( 4 );
+    ANN::IPerceptronGeneticAlgorithmTrainerRef trainer =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( TargetFitnessOp, 8, 4, 20, pool, 9 );
+    trainer->SetMutationProbability( 0.0f );
+
+    std::vector< std::vector< double > > parents = GetPopulation( *trainer );
+    trainer->Step();
+    std::vector< std::vector< double > > children = GetPopulation( *trainer );
+
+    for ( const auto & child : children )
+    {
+        for ( unsigned weight = 0; weight < child.size(); ++ weight )
+        {
+            bool inherited = false;
+            for ( const auto & parent : parents )
+            {
+                inherited = inherited || std::memcmp( &child[ weight ], &parent[ weight ], sizeof( double ) ) == 0;
+            }
+            EXPECT_TRUE( inherited );
+        }
+    }
+}
+
+TEST( PerceptronGeneticAlgorithmTrainer, SaveLoad )
+{
+    // A loaded search goes on as if it had never stopped, whatever the
+    // seed of the trainer it is loaded into
+    Cmn::ThreadPool pool( 4 );
+    ANN::IPerceptronGeneticAlgorithmTrainerRef first =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( TargetFitnessOp, 8, 4, 30, pool, 5 );
+    ANN::IPerceptronGeneticAlgorithmTrainerRef second =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( TargetFitnessOp, 8, 4, 30, pool, 6 );
+    ANN::IPerceptronGeneticAlgorithmTrainerRef other =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( TargetFitnessOp, 8, 4, 20, pool, 5 );
+
+    for ( unsigned generation = 0; generation < 5; ++ generation )
+    {
+        first->Step();
+    }
+
+    std::stringstream stream;
+    first->Save( stream );
+    std::string saved = stream.str();
+
+    std::istringstream truncated( saved.substr( 0, saved.size() / 2 ) );
+    EXPECT_FALSE( second->Load( truncated ) );
+    std::istringstream wrongShape( saved );
+    EXPECT_FALSE( other->Load( wrongShape ) );
+
+    std::istringstream complete( saved );
+    ASSERT_TRUE( second->Load( complete ) );
+    EXPECT_EQ( first->GetFittest()->GetWeights(), second->GetFittest()->GetWeights() );
+    for ( unsigned generation = 0; generation < 5; ++ generation )
+    {
+        EXPECT_EQ( first->Step(), second->Step() );
+    }
+    EXPECT_EQ( first->GetFittest()->GetWeights(), second->GetFittest()->GetWeights() );
+}
+
+TEST( PerceptronEvolutionStrategiesTrainer, Converges )
+{
+    const unsigned kPairCount = 10;
+    const unsigned kGenerationCount = 200;
+
+    Cmn::ThreadPool pool( 4 );
+    ANN::IPerceptronEvolutionStrategiesTrainerRef trainer =
+        ANN::CreatePerceptronEvolutionStrategiesTrainer( TargetFitnessOp, 8, 4, kPairCount, pool, 1 );
+    trainer->SetLearningRate( 0.05f );
+    trainer->SetNoiseDeviation( 0.05f );
+
+    double first = TargetFitnessOp( trainer->GetMean() );
+    for ( unsigned generation = 0; generation < kGenerationCount; ++ generation )
+    {
+        trainer->Step();
+    }
+
+    EXPECT_LT( TargetFitnessOp( trainer->GetMean() ), first * 0.1 );
+    EXPECT_LT( TargetFitnessOp( trainer->GetFittest() ), first * 0.1 );
+}
+
+TEST( PerceptronEvolutionStrategiesTrainer, Deterministic )
+{
+    // The mean is updated by ranges of weights on threads; the same seed
+    // must still give the same mean
+    Cmn::ThreadPool pool( 4 );
+    Cmn::ThreadPool singleThreadPool( 1 );
+    ANN::IPerceptronEvolutionStrategiesTrainerRef first =
+        ANN::CreatePerceptronEvolutionStrategiesTrainer( TargetFitnessOp, 300, 8, 5, pool, 7 );
+    ANN::IPerceptronEvolutionStrategiesTrainerRef second =
+        ANN::CreatePerceptronEvolutionStrategiesTrainer( TargetFitnessOp, 300, 8, 5, singleThreadPool, 7 );
+
+    for ( unsigned generation = 0; generation < 5; ++ generation )
+    {
+        EXPECT_EQ( first->Step(), second->Step() );
+    }
+    EXPECT_EQ( first->GetMean()->GetWeights(), second->GetMean()->GetWeights() );
+}
+
+TEST( PerceptronEvolutionStrategiesTrainer, SaveLoad )
+{
+    // The noise table of another seed is remade with the loaded seed
+    Cmn::ThreadPool pool( 4 );
+    ANN::IPerceptronEvolutionStrategiesTrainerRef first =
+        ANN::CreatePerceptronEvolutionStrategiesTrainer( TargetFitnessOp, 8, 4, 5, pool, 3 );
+    ANN::IPerceptronEvolutionStrategiesTrainerRef second =
+        ANN::CreatePerceptronEvolutionStrategiesTrainer( TargetFitnessOp, 8, 4, 5, pool, 4 );
+    ANN::IPerceptronEvolutionStrategiesTrainerRef other =
+        ANN::CreatePerceptronEvolutionStrategiesTrainer( TargetFitnessOp, 8, 4, 6, pool, 3 );
+
+    for ( unsigned generation = 0; generation < 5; ++ generation )
+    {
+        first->Step();
+    }
+
+    std::stringstream stream;
+    first->Save( stream );
+    std::string saved = stream.str();
+
+    std::istringstream truncated( saved.substr( 0, saved.size() - 1 ) );
+    EXPECT_FALSE( second->Load( truncated ) );
+    std::istringstream wrongShape( saved );
+    EXPECT_FALSE( other->Load( wrongShape ) );
+
+    std::istringstream complete( saved );
+    ASSERT_TRUE( second->Load( complete ) );
+    for ( unsigned generation = 0; generation < 5; ++ generation )
+    {
+        EXPECT_EQ( first->Step(), second->Step() );
+    }
+    EXPECT_EQ( first->GetMean()->GetWeights(), second->GetMean()->GetWeights() );
+}
+
+TEST( PerceptronGeneticAlgorithmTrainer, GenerationFitnessOp )
+{
+    // Evaluating whole generations changes nothing but the calls
+    Cmn::ThreadPool pool( 4 );
+    ANN::IPerceptronGeneticAlgorithmTrainerRef first =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( TargetFitnessOp, 8, 4, 20, pool, 3 );
+    ANN::IPerceptronGeneticAlgorithmTrainerRef second =
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( nullptr, 8, 4, 20, pool, 3 );
+
+    unsigned generationCount = 0;
+    second->SetGenerationFitnessOp(
+        [ &generationCount ] ( const std::vector< ANN::ConstPerceptronRef > & generation, std::vector< double > & fitness ) {
+            fitness.resize( generation.size() );
+            for ( unsigned i = 0; i < generation.size(); ++ i )
+            {
+                fitness[i] = TargetFitnessOp( generation[i] );
+            }
+            generationCount ++;
+        } );
+
+    for ( unsigned generation = 0; generation < 5; ++ generation )
+    {
+        EXPECT_EQ( first->Step(), second->Step() );
+    }
+    EXPECT_EQ( generationCount, 5u );
+}
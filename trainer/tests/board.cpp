@@ -0,0 +1,194 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "go/board.h"
+
+namespace {
+
+    go::Move Place( unsigned row, unsigned column )
+    {
+        go::Move move;
+        move.type   = go::MOVE_TYPE_PLACE;
+        move.row    = row;
+        move.column = column;
+        return move;
+    }
+
+    go::Move Pass()
+    {
+        go::Move move;
+        move.type = go::MOVE_TYPE_PASS;
+        return move;
+    }
+
+} // namespace
+
+TEST( Board, Capture )
+{
+    go::Board board( 9 );
+
+    // Black string of two in the corner, surrounded by white
+    EXPECT_TRUE( board.Play( go::COLOR_BLACK, Place( 0, 0 ) ) );
+    EXPECT_TRUE( board.Play( go::COLOR_BLACK, Place( 0, 1 ) ) );
+    EXPECT_TRUE( board.Play( go::COLOR_WHITE, Place( 1, 0 ) ) );
+    EXPECT_TRUE( board.Play( go::COLOR_WHITE, Place( 1, 1 ) ) );
+    EXPECT_EQ( go::CELL_BLACK, board( 0, 1 ) );
+
+    EXPECT_TRUE( board.Play( go::COLOR_WHITE, Place( 0, 2 ) ) );
+    EXPECT_EQ( go::CELL_EMPTY, board( 0, 0 ) );
+    EXPECT_EQ( go::CELL_EMPTY, board( 0, 1 ) );
+    EXPECT_EQ( go::CELL_WHITE, board( 0, 2 ) );
+
+    // The captured points are liberties again
+    EXPECT_TRUE( board.IsLegal( go::COLOR_BLACK, Place( 0, 1 ) ) );
+}
+
+TEST( Board, Suicide )
+{
+    go::Board board( 9 );
+
+    board.Play( go::COLOR_WHITE, Place( 0, 1 ) );
+    board.Play( go::COLOR_WHITE, Place( 1, 0 ) );
+
+    EXPECT_FALSE( board.IsLegal( go::COLOR_BLACK, Place( 0, 0 ) ) );
+    EXPECT_FALSE( board.Play( go::COLOR_BLACK, Place( 0, 0 ) ) );
+    EXPECT_EQ( go::CELL_EMPTY, board( 0, 0 ) );
+    EXPECT_TRUE( board.IsLegal( go::COLOR_WHITE, Place( 0, 0 ) ) );
+
+    // Not suicide when it captures
+    board.Play( go::COLOR_BLACK, Place( 0, 2 ) );
+    board.Play( go::COLOR_BLACK, Place( 1, 1 ) );
+    EXPECT_TRUE( board.IsLegal( go::COLOR_BLACK, Place( 0, 0 ) ) );
+    EXPECT_TRUE( board.Play( go::COLOR_BLACK, Place( 0, 0 ) ) );
+    EXPECT_EQ( go::CELL_EMPTY, board( 0, 1 ) );
+    EXPECT_EQ( go::CELL_WHITE, board( 1, 0 ) );
+
+    // Filling the own last liberty is suicide for a string too
+    board.Play( go::COLOR_WHITE, Place( 2, 0 ) );
+    board.Play( go::COLOR_WHITE, Place( 2, 1 ) );
+    board.Play( go::COLOR_WHITE, Place( 1, 2 ) );
+    board.Play( go::COLOR_WHITE, Place( 0, 3 ) );
+    EXPECT_FALSE( board.IsLegal( go::COLOR_BLACK, Place( 0, 1 ) ) );
+    EXPECT_TRUE( board.IsLegal( go::COLOR_WHITE, Place( 0, 1 ) ) );
+}
+
+TEST( Board, Ko )
+{
+    go::Board board( 9 );
+
+    //   0 1 2 3
+    // 0 . B W .
+    // 1 B . . W
+    // 2 . B W .
+    board.Play( go::COLOR_BLACK, Place( 0, 1 ) );
+    board.Play( go::COLOR_BLACK, Place( 1, 0 ) );
+    board.Play( go::COLOR_BLACK, Place( 2, 1 ) );
+    board.Play( go::COLOR_WHITE, Place( 0, 2 ) );
+    board.Play( go::COLOR_WHITE, Place( 1, 3 ) );
+    board.Play( go::COLOR_WHITE, Place( 2, 2 ) );
+
+    board.Play( go::COLOR_WHITE, Place( 1, 1 ) );
+    EXPECT_TRUE( board.Play( go::COLOR_BLACK, Place( 1, 2 ) ) );
+    EXPECT_EQ( go::CELL_EMPTY, board( 1, 1 ) );
+
+    // White can't retake at once, but can after a move elsewhere
+    EXPECT_FALSE( board.IsLegal( go::COLOR_WHITE, Place( 1, 1 ) ) );
+    EXPECT_TRUE( board.Play( go::COLOR_WHITE, Pass() ) );
+    EXPECT_TRUE( board.Play( go::COLOR_BLACK, Pass() ) );
+    EXPECT_TRUE( board.Play( go::COLOR_WHITE, Place( 1, 1 ) ) );
+    EXPECT_EQ( go::CELL_EMPTY, board( 1, 2 ) );
+}
+
+TEST( Board, Set )
+{
+    go::Board board( 9 );
+
+    board.Set( 0, 1, go::CELL_WHITE );
+    board.Set( 1, 0, go::CELL_WHITE );
+    board.Set( 1, 1, go::CELL_BLACK );
+    EXPECT_FALSE( board.IsLegal( go::COLOR_BLACK, Place( 0, 0 ) ) );
+
+    board.Set( 0, 2, go::CELL_BLACK );
+    EXPECT_TRUE( board.Play( go::COLOR_BLACK, Place( 2, 0 ) ) );
+    EXPECT_TRUE( board.Play( go::COLOR_BLACK, Place( 0, 0 ) ) );
+    EXPECT_EQ( go::CELL_EMPTY, board( 0, 1 ) );
+    EXPECT_EQ( go::CELL_EMPTY, board( 1, 0 ) );
+
+    go::Board copy( 9 );
+    copy.Copy( board );
+    EXPECT_FALSE( copy.IsLegal( go::COLOR_WHITE, Place( 0, 0 ) ) );
+    EXPECT_FALSE( copy.IsLegal( go::COLOR_WHITE, Place( 0, 1 ) ) );
+    EXPECT_TRUE( copy.IsLegal( go::COLOR_BLACK, Place( 0, 1 ) ) );
+}
+
+TEST( Board, LegalMoves )
+{
+    go::Board board( 9 );
+
+    board.Play( go::COLOR_WHITE, Place( 0, 1 ) );
+    board.Play( go::COLOR_WHITE, Place( 1, 0 ) );
+
+    std::vector< bool > legalMoves;
+    board.GetLegalMoves( go::COLOR_BLACK, legalMoves );
+    ASSERT_EQ( 82u, legalMoves.size() );
+    EXPECT_FALSE( legalMoves[ 0 ] );
+    EXPECT_FALSE( legalMoves[ 1 ] );
+    EXPECT_FALSE( legalMoves[ 9 ] );
+    EXPECT_TRUE( legalMoves[ 10 ] );
+    EXPECT_TRUE( legalMoves[ 81 ] );
+}
+
+TEST( Board, Hash )
+{
+    go::Board board( 9 );
+    go::Board other( 9 );
+    uint64_t emptyHash = board.GetPositionHash();
+
+    // Same stones by different move orders
+    board.Play( go::COLOR_BLACK, Place( 2, 2 ) );
+    board.Play( go::COLOR_WHITE, Place( 6, 6 ) );
+    board.Play( go::COLOR_BLACK, Place( 2, 6 ) );
+    other.Play( go::COLOR_BLACK, Place( 2, 6 ) );
+    other.Play( go::COLOR_WHITE, Place( 6, 6 ) );
+    other.Play( go::COLOR_BLACK, Place( 2, 2 ) );
+    EXPECT_EQ( board.GetPositionHash(), other.GetPositionHash() );
+    EXPECT_NE( emptyHash, board.GetPositionHash() );
+    EXPECT_NE( board.GetHash( go::COLOR_BLACK ), board.GetHash( go::COLOR_WHITE ) );
+
+    // Captured stones leave the hash
+    other.Clear();
+    other.Play( go::COLOR_WHITE, Place( 0, 0 ) );
+    other.Play( go::COLOR_BLACK, Place( 0, 1 ) );
+    other.Play( go::COLOR_BLACK, Place( 1, 0 ) );
+    go::Board expected( 9 );
+    expected.Set( 0, 1, go::CELL_BLACK );
+    expected.Set( 1, 0, go::CELL_BLACK );
+    EXPECT_EQ( expected.GetPositionHash(), other.GetPositionHash() );
+}
+
+TEST( Board, Superko )
+{
+    go::Board board( 9 );
+    board.SetSuperko( true );
+
+    // The ko of Board.Ko: after both sides pass, retaking the ko repeats
+    // the position before black took it
+    board.Play( go::COLOR_BLACK, Place( 0, 1 ) );
+    board.Play( go::COLOR_BLACK, Place( 1, 0 ) );
+    board.Play( go::COLOR_BLACK, Place( 2, 1 ) );
+    board.Play( go::COLOR_WHITE, Place( 0, 2 ) );
+    board.Play( go::COLOR_WHITE, Place( 1, 3 ) );
+    board.Play( go::COLOR_WHITE, Place( 2, 2 ) );
+    board.Play( go::COLOR_WHITE, Place( 1, 1 ) );
+    EXPECT_TRUE( board.Play( go::COLOR_BLACK, Place( 1, 2 ) ) );
+    EXPECT_TRUE( board.Play( go::COLOR_WHITE, Pass() ) );
+    EXPECT_TRUE( board.Play( go::COLOR_BLACK, Pass() ) );
+
+    EXPECT_FALSE( board.IsLegal( go::COLOR_WHITE, Place( 1, 1 ) ) );
+    board.SetSuperko( false );
+    EXPECT_TRUE( board.IsLegal( go::COLOR_WHITE, Place( 1, 1 ) ) );
+}
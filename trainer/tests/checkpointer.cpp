@@ -0,0 +1,39 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "training/checkpointer.h"
+
+#include <cstdio>
+
+TEST( Checkpointer, SaveAndLoad )
+{
+    const char * kPath = "checkpointer_test.ckpt";
+    std::remove( kPath );
+
+    training::Checkpointer checkpointer( kPath );
+
+    std::string snapshot;
+    EXPECT_FALSE( checkpointer.Load( snapshot ) );
+
+    for ( unsigned i = 0; i < 20; ++ i )
+    {
+        checkpointer.Save( std::string( 1000, static_cast< char >( 'a' + i ) ) + '\0' );
+    }
+    EXPECT_TRUE( checkpointer.Wait() );
+
+    // Only the newest snapshot is left, the temporary file is gone
+    ASSERT_TRUE( checkpointer.Load( snapshot ) );
+    EXPECT_EQ( std::string( 1000, 'a' + 19 ) + '\0', snapshot );
+    std::FILE * temporary = std::fopen( "checkpointer_test.ckpt.tmp", "rb" );
+    EXPECT_EQ( nullptr, temporary );
+    if ( temporary != nullptr )
+    {
+        std::fclose( temporary );
+    }
+
+    std::remove( kPath );
+}
@@ -0,0 +1,101 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "go/board.h"
+#include "go/feature_encoder.h"
+
+#include <random>
+
+TEST( FeatureEncoder, IncrementalMatchesRebuild )
+{
+    // Planes kept up to date move by move must equal the planes encoded
+    // from scratch, and the legal plane must agree with the board
+
+    const unsigned kSizes[] = { 5, 9, 19 };
+    const unsigned kHistoryLength = 3;
+
+    std::default_random_engine random( 1 );
+
+    for ( unsigned size : kSizes )
+    {
+        unsigned cellCount = size * size;
+
+        go::FeatureEncoder encoder( size, kHistoryLength );
+        go::FeatureEncoder reference( size, kHistoryLength );
+        unsigned legalPlane = encoder.GetLegalPlane();
+
+        std::vector< bool > legalMoves;
+        std::vector< unsigned > candidates;
+        std::vector< unsigned > lastMoves;
+
+        for ( unsigned ply = 0; ply < cellCount * 3; ++ ply )
+        {
+            go::Color color = static_cast< go::Color >( ply & 1 );
+
+            encoder.GetBoard().GetLegalMoves( color, legalMoves );
+            candidates.clear();
+            for ( unsigned i = 0; i < cellCount; ++ i )
+            {
+                if ( legalMoves[i] )
+                {
+                    candidates.push_back( i );
+                }
+            }
+
+            go::Move move;
+            move.type = go::MOVE_TYPE_PASS;
+            unsigned point = cellCount;
+            if ( !candidates.empty() && random() % 20 != 0 )
+            {
+                point = candidates[ random() % candidates.size() ];
+                move.type   = go::MOVE_TYPE_PLACE;
+                move.row    = point / size;
+                move.column = point % size;
+            }
+            lastMoves.insert( lastMoves.begin(), point );
+
+            ASSERT_TRUE( encoder.Play( color, move ) );
+            reference.SetPosition( encoder.GetBoard() );
+
+            for ( go::Color toMove : { go::COLOR_BLACK, go::COLOR_WHITE } )
+            {
+                const float * features = encoder.GetFeatures( toMove );
+                const float * expected = reference.GetFeatures( toMove );
+
+                for ( unsigned plane = 0; plane < encoder.GetPlaneCount(); ++ plane )
+                {
+                    if ( plane >= go::FeatureEncoder::PLANE_HISTORY && plane < legalPlane )
+                    {
+                        continue;
+                    }
+                    for ( unsigned i = 0; i < cellCount; ++ i )
+                    {
+                        ASSERT_EQ( expected[ plane * cellCount + i ], features[ plane * cellCount + i ] )
+                            << "size " << size << " ply " << ply << " plane " << plane << " point " << i;
+                    }
+                }
+
+                encoder.GetBoard().GetLegalMoves( toMove, legalMoves );
+                for ( unsigned i = 0; i < cellCount; ++ i )
+                {
+                    ASSERT_EQ( legalMoves[i] ? 1.0f : 0.0f, features[ legalPlane * cellCount + i ] );
+                }
+
+                // One point per history plane at most, at the move of its age
+                for ( unsigned age = 0; age < kHistoryLength; ++ age )
+                {
+                    const float * history = features + ( go::FeatureEncoder::PLANE_HISTORY + age ) * cellCount;
+                    for ( unsigned i = 0; i < cellCount; ++ i )
+                    {
+                        bool expectedMove = age < lastMoves.size() && lastMoves[ age ] == i;
+                        ASSERT_EQ( expectedMove ? 1.0f : 0.0f, history[i] );
+                    }
+                }
+            }
+        }
+    }
+}
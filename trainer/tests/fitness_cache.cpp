@@ -0,0 +1,60 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "ann/perceptron.h"
+#include "training/fitness_cache.h"
+
+#include <sstream>
+#include <vector>
+
+TEST( FitnessCache, LeastRecentlyUsed )
+{
+    training::FitnessCache cache( 3 );
+    cache.Insert( 1, 1.0 );
+    cache.Insert( 2, 2.0 );
+    cache.Insert( 3, 3.0 );
+
+    // 1 is used again, so 2 goes first
+    double fitness = 0.0;
+    EXPECT_TRUE( cache.Find( 1, fitness ) );
+    EXPECT_EQ( fitness, 1.0 );
+
+    cache.Insert( 4, 4.0 );
+    EXPECT_EQ( cache.GetSize(), 3u );
+    EXPECT_FALSE( cache.Find( 2, fitness ) );
+    EXPECT_TRUE( cache.Find( 3, fitness ) );
+    EXPECT_TRUE( cache.Find( 4, fitness ) );
+
+    // Saved and loaded into a smaller cache, the most recent ones stay
+    std::stringstream stream;
+    cache.Save( stream );
+
+    training::FitnessCache loaded( 2 );
+    ASSERT_TRUE( loaded.Load( stream ) );
+    EXPECT_EQ( loaded.GetSize(), 2u );
+    EXPECT_FALSE( loaded.Find( 1, fitness ) );
+    EXPECT_TRUE( loaded.Find( 3, fitness ) );
+    EXPECT_EQ( fitness, 3.0 );
+    EXPECT_TRUE( loaded.Find( 4, fitness ) );
+    EXPECT_EQ( fitness, 4.0 );
+
+    std::istringstream truncated( stream.str().substr( 0, 12 ) );
+    EXPECT_FALSE( loaded.Load( truncated ) );
+}
+
+TEST( FitnessCache, Key )
+{
+    std::vector< double > weights( 82 * 82, 0.25 );
+    ANN::Perceptron perceptron( 81, 82, weights.data() );
+    uint64_t key = training::FitnessCache::GetKey( perceptron, 1 );
+
+    EXPECT_EQ( key, training::FitnessCache::GetKey( ANN::Perceptron( 81, 82, weights.data() ), 1 ) );
+    EXPECT_NE( key, training::FitnessCache::GetKey( perceptron, 2 ) );
+
+    weights[ 1000 ] += 1e-9;
+    EXPECT_NE( key, training::FitnessCache::GetKey( ANN::Perceptron( 81, 82, weights.data() ), 1 ) );
+}
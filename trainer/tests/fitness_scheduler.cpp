@@ -0,0 +1,170 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "ann/seed.h"
+#include "cmn/thread_pool.h"
+#include "training/fitness_scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+TEST( ThreadPool, NestedSubmit )
+{
+    Cmn::ThreadPool pool( 4 );
+    std::atomic< unsigned > count( 0 );
+
+    for ( unsigned i = 0; i < 100; ++ i )
+    {
+        pool.Submit( [ &pool, &count ] {
+            for ( unsigned j = 0; j < 10; ++ j )
+            {
+                pool.Submit( [ &count ] { count ++; } );
+            }
+            count ++;
+        } );
+    }
+
+    pool.Wait();
+    EXPECT_EQ( 1100u, count.load() );
+}
+
+TEST( ThreadPool, Exception )
+{
+    Cmn::ThreadPool pool( 2 );
+    pool.Submit( [] { throw std::runtime_error( "task" ); } );
+    EXPECT_THROW( pool.Wait(), std::runtime_error );
+
+    // The pool is still usable
+    bool done = false;
+    pool.Submit( [ &done ] { done = true; } );
+    pool.Wait();
+    EXPECT_TRUE( done );
+}
+
+TEST( ThreadPool, TaskGroup )
+{
+    Cmn::ThreadPool pool( 2 );
+
+    // A task of another client keeps running through the group's wait
+    std::atomic< bool > release( false );
+    pool.Submit( [ &release ] {
+        while ( !release )
+        {
+            std::this_thread::yield();
+        }
+    } );
+
+    Cmn::TaskGroup group( pool );
+    std::atomic< unsigned > count( 0 );
+    for ( unsigned i = 0; i < 100; ++ i )
+    {
+        group.Submit( [ &count ] { count ++; } );
+    }
+    group.Wait();
+    EXPECT_EQ( 100u, count.load() );
+    EXPECT_FALSE( release );
+
+    // Exceptions go to the group only
+    group.Submit( [] { throw std::runtime_error( "task" ); } );
+    EXPECT_THROW( group.Wait(), std::runtime_error );
+
+    release = true;
+    pool.Wait();
+}
+
+TEST( FitnessScheduler, Deterministic )
+{
+    const unsigned kIndividualCount = 7;
+    const unsigned kGameCount       = 13;
+
+    // Scores whose sum depends on the order they're added in
+    auto gameOp = [] ( unsigned individual, unsigned game ) {
+        return ( game % 2 ? 1e16 : -1e16 ) + individual * 0.1 + game;
+    };
+
+    std::vector< double > expected;
+    {
+        Cmn::ThreadPool pool( 1 );
+        training::FitnessScheduler scheduler( pool );
+        scheduler.Evaluate( kIndividualCount, kGameCount, gameOp, expected );
+    }
+
+    Cmn::ThreadPool pool( 8 );
+    training::FitnessScheduler scheduler( pool );
+    for ( unsigned run = 0; run < 10; ++ run )
+    {
+        std::vector< double > fitness;
+        scheduler.Evaluate( kIndividualCount, kGameCount, gameOp, fitness );
+        EXPECT_EQ( expected, fitness );
+    }
+}
+
+TEST( FitnessScheduler, Racing )
+{
+    const unsigned kIndividualCount = 10;
+    const unsigned kGameCount       = 50;
+    const unsigned kEliteCount      = 2;
+
+    Cmn::ThreadPool pool( 4 );
+    training::FitnessScheduler scheduler( pool );
+
+    for ( unsigned run = 0; run < 20; ++ run )
+    {
+        // Individual i scores around 3 * i, give or take 3, the noise
+        // changing from game to game
+        auto gameOp = [ run ] ( unsigned individual, unsigned game ) {
+            uint64_t hash = ANN::MixSeed( ( uint64_t( run ) << 40 ) ^ ( uint64_t( individual ) << 20 ) ^ game );
+            return individual * 3.0 + ( hash % 6001 ) / 1000.0 - 3.0;
+        };
+
+        std::vector< double > expected;
+        scheduler.Evaluate( kIndividualCount, kGameCount, gameOp, expected );
+
+        training::FitnessScheduler::RacingOptions options( kEliteCount );
+        std::vector< double > fitness;
+        unsigned gameCount = scheduler.EvaluateRacing( kIndividualCount, kGameCount, options, gameOp, fitness );
+
+        // The hopeless ones are dropped early
+        EXPECT_LT( gameCount, kIndividualCount * kGameCount / 2 );
+        EXPECT_LT( scheduler.GetPlayedGameCount( kIndividualCount - 1 ), kGameCount );
+
+        // The elite by all the games are the elite by racing, and play
+        // every game
+        std::vector< unsigned > expectedRanking( kIndividualCount );
+        std::iota( expectedRanking.begin(), expectedRanking.end(), 0 );
+        std::stable_sort( expectedRanking.begin(), expectedRanking.end(),
+            [ &expected ] ( unsigned a, unsigned b ) { return expected[a] < expected[b]; } );
+
+        std::vector< unsigned > ranking( kIndividualCount );
+        std::iota( ranking.begin(), ranking.end(), 0 );
+        std::stable_sort( ranking.begin(), ranking.end(),
+            [ &fitness ] ( unsigned a, unsigned b ) { return fitness[a] < fitness[b]; } );
+
+        for ( unsigned rank = 0; rank < kEliteCount; ++ rank )
+        {
+            EXPECT_EQ( expectedRanking[ rank ], ranking[ rank ] );
+            EXPECT_EQ( expected[ expectedRanking[ rank ] ], fitness[ expectedRanking[ rank ] ] );
+            EXPECT_EQ( kGameCount, scheduler.GetPlayedGameCount( expectedRanking[ rank ] ) );
+        }
+    }
+
+    // Nothing to tell apart: everyone plays everything
+    auto gameOp = [] ( unsigned individual, unsigned game ) {
+        return individual * 3.0 + ( ANN::MixSeed( ( uint64_t( individual ) << 20 ) ^ game ) % 6001 ) / 1000.0 - 3.0;
+    };
+    std::vector< double > expected;
+    scheduler.Evaluate( kIndividualCount, kGameCount, gameOp, expected );
+
+    std::vector< double > fitness;
+    training::FitnessScheduler::RacingOptions allElite( kIndividualCount );
+    EXPECT_EQ( kIndividualCount * kGameCount,
+               scheduler.EvaluateRacing( kIndividualCount, kGameCount, allElite, gameOp, fitness ) );
+    EXPECT_EQ( expected, fitness );
+}
@@ -5,17 +5,24 @@ CMN_WARNING_DISABLE_MSVC( 4625 4626 )
 #include "gtest/gtest.h"
 CMN_WARNING_POP
 
-#include "gnugo/engine.h"
+#include "gnugo/engine_pool.h"
+#include "gnugo/exceptions.h"
 #include "gnugo/game.h"
+#include "gnugo/gtp_engine.h"
+#include "gnugo/native_engine.h"
 #include "gnugo/player.h"
 #include "gnugo/player_random.h"
+#include "go/board.h"
+
+#include <thread>
+#include <vector>
 
 TEST( LearningService, Game )
 {
     const unsigned kBoardSize = 9;
     const unsigned kLevel     = 1;
 
-    gnugo::Engine engine( kLevel, kBoardSize );
+    gnugo::GtpEngine engine( kLevel, kBoardSize );
     gnugo::Player blackPlayer( engine );
     gnugo::Player whitePlayer( engine );
     gnugo::Game game( kBoardSize, blackPlayer, whitePlayer, engine );
@@ -28,10 +35,208 @@ TEST( LearningService, PlayerRandom )
     const unsigned kBoardSize = 9;
     const unsigned kLevel     = 1;
 
-    gnugo::Engine engine( kLevel, kBoardSize );
+    gnugo::GtpEngine engine( kLevel, kBoardSize );
     gnugo::PlayerRandom blackPlayer( engine );
     gnugo::Player whitePlayer( engine );
     gnugo::Game game( kBoardSize, blackPlayer, whitePlayer, engine );
 
     game.Play();
 }
+
+namespace {
+
+    // Checks the board the game keeps against the engine's position before
+    // handing the move over to gnugo::Player
+
+    class PlayerCheckingBoard : public gnugo::Player
+    {
+    public:
+        go::Move
+        MakeMove( const go::Board & board )
+        {
+            go::Board engineBoard( board.GetSize() );
+            mEngine.UpdateBoard( engineBoard );
+            for ( unsigned row = 0; row < board.GetSize(); ++ row )
+            {
+                for ( unsigned column = 0; column < board.GetSize(); ++ column )
+                {
+                    EXPECT_EQ( engineBoard( row, column ), board( row, column ) );
+                }
+            }
+            return gnugo::Player::MakeMove( board );
+        }
+
+    public:
+        PlayerCheckingBoard( gnugo::Engine & engine )
+            : gnugo::Player( engine )
+        {}
+    };
+
+    class GameExposed : public gnugo::Game
+    {
+    public:
+        using gnugo::Game::Init;
+        using gnugo::Game::UpdateBoard;
+
+    public:
+        GameExposed( unsigned boardSize, gnugo::PlayerBase & black, gnugo::PlayerBase & white, gnugo::Engine & engine )
+            : gnugo::Game( boardSize, black, white, engine )
+        {}
+    };
+
+} // namespace
+
+TEST( LearningService, BoardResync )
+{
+    const unsigned kBoardSize = 9;
+    const unsigned kLevel     = 1;
+
+    gnugo::NativeEngine engine( kLevel, kBoardSize, 1 );
+    gnugo::Player blackPlayer( engine );
+    gnugo::Player whitePlayer( engine );
+    GameExposed game( kBoardSize, blackPlayer, whitePlayer, engine );
+    game.Init();
+
+    go::Move first;
+    first.row       = 0;
+    first.column    = 0;
+    ASSERT_TRUE( engine.Play( go::COLOR_BLACK, first ) );
+    game.UpdateBoard( go::COLOR_BLACK, first );
+
+    // White's move reported wrong: the board refuses the occupied point
+    // and follows the engine instead
+    go::Move second;
+    second.row      = 0;
+    second.column   = 1;
+    ASSERT_TRUE( engine.Play( go::COLOR_WHITE, second ) );
+    game.UpdateBoard( go::COLOR_WHITE, first );
+
+    EXPECT_EQ( go::CELL_BLACK, game.GetBoard()( 0, 0 ) );
+    EXPECT_EQ( go::CELL_WHITE, game.GetBoard()( 0, 1 ) );
+}
+
+TEST( LearningService, BoardInSync )
+{
+    const unsigned kBoardSize = 9;
+    const unsigned kLevel     = 1;
+
+    gnugo::NativeEngine engine( kLevel, kBoardSize, 1 );
+    gnugo::PlayerRandom blackPlayer( engine, 1 );
+    PlayerCheckingBoard whitePlayer( engine );
+    gnugo::Game game( kBoardSize, blackPlayer, whitePlayer, engine );
+
+    game.Play();
+    game.Play();
+}
+
+TEST( LearningService, EnginePool )
+{
+    const unsigned kBoardSize = 9;
+    const unsigned kLevel     = 1;
+
+    gnugo::EnginePool pool;
+    gnugo::GtpEngine * first = nullptr;
+
+    for ( unsigned i = 0; i < 2; ++ i )
+    {
+        auto engine = pool.Acquire( kLevel, kBoardSize );
+        if ( first == nullptr )
+        {
+            first = engine.get();
+        }
+        EXPECT_EQ( first, engine.get() );
+
+        gnugo::PlayerRandom blackPlayer( *engine );
+        gnugo::Player whitePlayer( *engine );
+        gnugo::Game game( kBoardSize, blackPlayer, whitePlayer, *engine );
+        game.Play();
+
+        std::list< go::Stone > stones;
+        engine->ListStones( stones );
+        EXPECT_FALSE( stones.empty() );
+    }
+
+    EXPECT_EQ( 1u, pool.GetIdleCount() );
+
+    // A returned engine starts from an empty board
+    auto engine = pool.Acquire( kLevel, kBoardSize );
+    std::list< go::Stone > stones;
+    engine->ListStones( stones );
+    EXPECT_TRUE( stones.empty() );
+    EXPECT_EQ( 0u, pool.GetIdleCount() );
+}
+
+TEST( LearningService, EnginePoolRespawn )
+{
+    const unsigned kBoardSize = 9;
+    const unsigned kLevel     = 1;
+
+    gnugo::EnginePool pool;
+
+    {
+        auto engine = pool.Acquire( kLevel, kBoardSize );
+        engine->Execute( "quit" );
+    }
+
+    // The dead engine is thrown away instead of going back to the pool
+    EXPECT_EQ( 0u, pool.GetIdleCount() );
+
+    auto engine = pool.Acquire( kLevel, kBoardSize );
+    EXPECT_TRUE( engine->IsAlive() );
+    std::list< go::Stone > stones;
+    engine->ListStones( stones );
+    EXPECT_TRUE( stones.empty() );
+}
+
+TEST( LearningService, GtpEngineFailure )
+{
+    const unsigned kBoardSize = 9;
+    const unsigned kLevel     = 1;
+
+    gnugo::GtpEngine engine( kLevel, kBoardSize );
+    engine.Execute( "quit" );
+
+    // Writing to the dead engine must neither raise SIGPIPE nor hang
+    EXPECT_THROW( engine.Execute( "showboard" ), gnugo::EngineFailure );
+    EXPECT_THROW( engine.Execute( "showboard" ), gnugo::EngineFailure );
+}
+
+TEST( LearningService, NativeEngine )
+{
+    const unsigned kBoardSize = 9;
+    const unsigned kLevel     = 1;
+
+    gnugo::NativeEngine engine( kLevel, kBoardSize );
+    gnugo::PlayerRandom blackPlayer( engine );
+    gnugo::Player whitePlayer( engine );
+    gnugo::Game game( kBoardSize, blackPlayer, whitePlayer, engine );
+
+    game.Play();
+    engine.GetScore( go::COLOR_WHITE );
+}
+
+TEST( LearningService, NativeEngineThreads )
+{
+    const unsigned kBoardSize   = 9;
+    const unsigned kLevel       = 1;
+    const unsigned kThreadCount = 4;
+
+    std::vector< std::thread > threads;
+    for ( unsigned i = 0; i < kThreadCount; ++ i )
+    {
+        threads.emplace_back( [ i ] {
+            gnugo::NativeEngine engine( kLevel, kBoardSize, i + 1 );
+            gnugo::PlayerRandom blackPlayer( engine, i );
+            gnugo::Player whitePlayer( engine );
+            gnugo::Game game( kBoardSize, blackPlayer, whitePlayer, engine );
+
+            game.Play();
+            engine.GetScore( go::COLOR_WHITE );
+        } );
+    }
+
+    for ( auto & thread : threads )
+    {
+        thread.join();
+    }
+}
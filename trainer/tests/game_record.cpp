@@ -0,0 +1,158 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "go/board.h"
+#include "go/game_record.h"
+#include "go/local_game.h"
+#include "go/player_random.h"
+#include "training/game_recorder.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+TEST( GameRecord, EncodeAndReplay )
+{
+    const unsigned kBoardSize = 9;
+
+    go::PlayerRandom black( 1 );
+    go::PlayerRandom white( 2 );
+    go::LocalGame game( kBoardSize, black, white );
+    game.Play();
+
+    go::GameRecord record;
+    record.boardSize    = kBoardSize;
+    record.blackPlayer  = "random-1";
+    record.whitePlayer  = "random-2";
+    record.seed         = 77;
+    record.score        = -3.5f;
+    record.moves        = game.GetMoves();
+
+    std::vector< uint8_t > buffer( go::kGameRecordMagic, go::kGameRecordMagic + 4 );
+    go::EncodeGameRecord( record, buffer );
+    go::EncodeGameRecord( record, buffer );
+
+    // One byte per move on 9x9, plus a short header
+    EXPECT_LT( buffer.size(), 2 * ( record.moves.size() + 40 ) );
+
+    std::istringstream stream( std::string( buffer.begin(), buffer.end() ) );
+    go::GameRecordReader reader( stream );
+    ASSERT_TRUE( reader.IsValid() );
+
+    for ( unsigned i = 0; i < 2; ++ i )
+    {
+        go::GameRecord read;
+        ASSERT_TRUE( reader.Read( read ) );
+        EXPECT_EQ( record.blackPlayer, read.blackPlayer );
+        EXPECT_EQ( record.whitePlayer, read.whitePlayer );
+        EXPECT_EQ( record.seed, read.seed );
+        EXPECT_EQ( record.score, read.score );
+        ASSERT_EQ( record.moves.size(), read.moves.size() );
+
+        go::Board board( kBoardSize );
+        ASSERT_TRUE( go::ReplayGameRecord( read, board ) );
+        EXPECT_EQ( game.GetBoard().GetPositionHash(), board.GetPositionHash() );
+    }
+
+    go::GameRecord end;
+    EXPECT_FALSE( reader.Read( end ) );
+}
+
+TEST( GameRecord, Recorder )
+{
+    const char * kPath = "game_record_test.rec";
+    std::remove( kPath );
+
+    go::GameRecord record;
+    record.boardSize = 9;
+    record.moves.resize( 50 );
+    for ( unsigned i = 0; i < record.moves.size(); ++ i )
+    {
+        record.moves[i].row     = i / 9;
+        record.moves[i].column  = i % 9;
+    }
+
+    {
+        // Small buffer, so records cross several handovers
+        training::GameRecorder recorder( kPath, 256 );
+        ASSERT_TRUE( recorder.IsOpen() );
+        for ( unsigned i = 0; i < 100; ++ i )
+        {
+            record.seed = i;
+            recorder.Record( record );
+        }
+    }
+
+    std::ifstream stream( kPath, std::ios::in | std::ios::binary );
+    go::GameRecordReader reader( stream );
+    ASSERT_TRUE( reader.IsValid() );
+
+    unsigned count = 0;
+    go::GameRecord read;
+    while ( reader.Read( read ) )
+    {
+        EXPECT_EQ( count, read.seed );
+        EXPECT_EQ( 50u, read.moves.size() );
+        count ++;
+    }
+    EXPECT_EQ( 100u, count );
+
+    stream.close();
+    std::remove( kPath );
+}
+
+TEST( GameRecord, RecorderTornRecord )
+{
+    const char * kPath = "game_record_torn.rec";
+    std::remove( kPath );
+
+    go::GameRecord record;
+    record.boardSize = 9;
+    record.moves.resize( 20 );
+    for ( go::Move & move : record.moves )
+    {
+        move.type = go::MOVE_TYPE_PASS;
+    }
+
+    for ( unsigned i = 0; i < 2; ++ i )
+    {
+        record.seed = i;
+        training::GameRecorder recorder( kPath );
+        recorder.Record( record );
+    }
+
+    {
+        // A crash in the middle of the third record
+        std::vector< uint8_t > buffer;
+        go::EncodeGameRecord( record, buffer );
+        std::ofstream stream( kPath, std::ios::out | std::ios::binary | std::ios::app );
+        stream.write( reinterpret_cast< const char * >( buffer.data() ), buffer.size() / 2 );
+    }
+
+    {
+        record.seed = 2;
+        training::GameRecorder recorder( kPath );
+        ASSERT_TRUE( recorder.IsOpen() );
+        recorder.Record( record );
+    }
+
+    std::ifstream stream( kPath, std::ios::in | std::ios::binary );
+    go::GameRecordReader reader( stream );
+    ASSERT_TRUE( reader.IsValid() );
+
+    unsigned count = 0;
+    go::GameRecord read;
+    while ( reader.Read( read ) )
+    {
+        EXPECT_EQ( count, read.seed );
+        count ++;
+    }
+    EXPECT_EQ( 3u, count );
+
+    stream.close();
+    std::remove( kPath );
+}
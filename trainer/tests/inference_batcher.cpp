@@ -0,0 +1,136 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "training/inference_batcher.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+TEST( InferenceBatcher, ConcurrentRows )
+{
+    const unsigned kThreadCount = 8;
+    const unsigned kCallCount   = 200;
+
+    std::atomic< unsigned > batchCount( 0 );
+    std::atomic< unsigned > rowCount( 0 );
+
+    // Two outputs per row: the sum and the difference of the inputs
+    auto forward = [ &batchCount, &rowCount ] ( const std::vector< double > & inputs, unsigned rows,
+                                                std::vector< double > & outputs ) {
+        for ( unsigned i = 0; i < rows; ++ i )
+        {
+            outputs[ i * 2 ]     = inputs[ i * 2 ] + inputs[ i * 2 + 1 ];
+            outputs[ i * 2 + 1 ] = inputs[ i * 2 ] - inputs[ i * 2 + 1 ];
+        }
+        batchCount ++;
+        rowCount += rows;
+    };
+
+    training::InferenceBatcher batcher( 2, 2, forward, 4, std::chrono::microseconds( 200 ) );
+
+    std::vector< std::thread > threads;
+    for ( unsigned t = 0; t < kThreadCount; ++ t )
+    {
+        threads.emplace_back( [ &batcher, t ] {
+            std::vector< double > inputs( 2 );
+            std::vector< double > outputs;
+            for ( unsigned i = 0; i < kCallCount; ++ i )
+            {
+                inputs[0] = t;
+                inputs[1] = i;
+                batcher.Compute( inputs, outputs );
+                ASSERT_EQ( 2u, outputs.size() );
+                EXPECT_EQ( double( t + i ), outputs[0] );
+                EXPECT_EQ( double( t ) - i, outputs[1] );
+            }
+        } );
+    }
+
+    for ( auto & thread : threads )
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ( kThreadCount * kCallCount, rowCount.load() );
+    EXPECT_LT( batchCount.load(), rowCount.load() );
+}
+
+TEST( InferenceBatcher, MultipleRows )
+{
+    auto forward = [] ( const std::vector< double > & inputs, unsigned rows, std::vector< double > & outputs ) {
+        for ( unsigned i = 0; i < rows; ++ i )
+        {
+            outputs[i] = inputs[i] * 10.0;
+        }
+    };
+
+    training::InferenceBatcher batcher( 1, 1, forward, 8, std::chrono::microseconds( 200 ) );
+
+    std::vector< std::thread > threads;
+    for ( unsigned t = 0; t < 4; ++ t )
+    {
+        threads.emplace_back( [ &batcher, t ] {
+            std::vector< double > inputs( 3 + t );
+            std::vector< double > outputs;
+            for ( unsigned i = 0; i < 100; ++ i )
+            {
+                for ( unsigned row = 0; row < inputs.size(); ++ row )
+                {
+                    inputs[ row ] = t * 1000 + i * 10 + row;
+                }
+                batcher.Compute( inputs, outputs );
+                ASSERT_EQ( inputs.size(), outputs.size() );
+                for ( unsigned row = 0; row < inputs.size(); ++ row )
+                {
+                    EXPECT_EQ( inputs[ row ] * 10.0, outputs[ row ] );
+                }
+            }
+        } );
+    }
+
+    for ( auto & thread : threads )
+    {
+        thread.join();
+    }
+}
+
+TEST( InferenceBatcher, ForwardThrows )
+{
+    // Every caller of a failed batch gets the exception instead of waiting
+    // for outputs forever
+    auto forward = [] ( const std::vector< double > &, unsigned, std::vector< double > & ) {
+        throw std::runtime_error( "forward" );
+    };
+
+    training::InferenceBatcher batcher( 1, 1, forward, 4, std::chrono::milliseconds( 50 ) );
+
+    std::atomic< unsigned > thrown( 0 );
+    std::vector< std::thread > threads;
+    for ( unsigned t = 0; t < 6; ++ t )
+    {
+        threads.emplace_back( [ &batcher, &thrown ] {
+            std::vector< double > inputs( 1, 1.0 );
+            std::vector< double > outputs;
+            try
+            {
+                batcher.Compute( inputs, outputs );
+            }
+            catch ( const std::runtime_error & )
+            {
+                thrown ++;
+            }
+        } );
+    }
+
+    for ( auto & thread : threads )
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ( 6u, thrown.load() );
+}
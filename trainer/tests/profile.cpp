@@ -0,0 +1,73 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "cmn/profile.h"
+
+#include <thread>
+#include <vector>
+
+static const Cmn::ProfileStat * FindStat( const std::vector< Cmn::ProfileStat > & stats, const char * name )
+{
+    for ( auto & stat : stats )
+    {
+        if ( stat.name == name )
+        {
+            return &stat;
+        }
+    }
+    return nullptr;
+}
+
+TEST( Profile, AggregatesThreads )
+{
+    static Cmn::ProfilePoint counter( "test.counter", Cmn::PROFILE_KIND_COUNTER );
+    static Cmn::ProfilePoint histogram( "test.histogram", Cmn::PROFILE_KIND_HISTOGRAM );
+    static Cmn::ProfilePoint timer( "test.timer", Cmn::PROFILE_KIND_TIMER );
+
+    std::vector< Cmn::ProfileStat > stats;
+    Cmn::GetProfileStats( stats, true );
+
+    std::vector< std::thread > threads;
+    for ( unsigned i = 0; i < 4; ++ i )
+    {
+        threads.emplace_back( [] {
+            for ( uint64_t value = 0; value < 1000; ++ value )
+            {
+                counter.Add( 2 );
+                histogram.Record( value );
+                Cmn::ProfileTimer scope( timer );
+            }
+        } );
+    }
+    for ( auto & thread : threads )
+    {
+        thread.join();
+    }
+
+    Cmn::GetProfileStats( stats, true );
+
+    const Cmn::ProfileStat * stat = FindStat( stats, "test.counter" );
+    ASSERT_NE( stat, nullptr );
+    EXPECT_EQ( stat->sum, 8000u );
+
+    stat = FindStat( stats, "test.histogram" );
+    ASSERT_NE( stat, nullptr );
+    EXPECT_EQ( stat->count, 4000u );
+    EXPECT_EQ( stat->sum, 4u * 999u * 1000u / 2u );
+    EXPECT_EQ( stat->buckets[0], 4u );
+    EXPECT_EQ( stat->GetPercentile( 50.0 ), 511u );
+    EXPECT_EQ( stat->GetPercentile( 100.0 ), 1023u );
+
+    stat = FindStat( stats, "test.timer" );
+    ASSERT_NE( stat, nullptr );
+    EXPECT_EQ( stat->count, 4000u );
+
+    // Reset: nothing recorded since the last call
+    Cmn::GetProfileStats( stats );
+    EXPECT_EQ( FindStat( stats, "test.histogram" )->count, 0u );
+    EXPECT_FALSE( Cmn::ProfileReport().empty() );
+}
@@ -0,0 +1,103 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "gnugo/caching_engine.h"
+#include "gnugo/game.h"
+#include "gnugo/gtp_engine.h"
+#include "gnugo/player.h"
+#include "gnugo/player_random.h"
+#include "gnugo/reply_cache.h"
+
+#include <sstream>
+#include <vector>
+
+namespace {
+
+    class CountingEngine : public gnugo::GtpEngine
+    {
+    public:
+        go::Move
+        Genmove( go::Color color )
+        {
+            mGenmoveCount ++;
+            return gnugo::GtpEngine::Genmove( color );
+        }
+
+        unsigned
+        GetGenmoveCount() const { return mGenmoveCount; }
+
+    public:
+        CountingEngine( unsigned level, unsigned boardSize )
+            : gnugo::GtpEngine( level, boardSize )
+            , mGenmoveCount( 0 )
+        {}
+
+    private:
+        unsigned    mGenmoveCount;
+    };
+
+    std::vector< go::Move > PlayGame( gnugo::Engine & engine, unsigned boardSize )
+    {
+        gnugo::PlayerRandom blackPlayer( engine, 1 );
+        gnugo::Player       whitePlayer( engine );
+        gnugo::Game         game( boardSize, blackPlayer, whitePlayer, engine );
+        game.Play();
+        return game.GetMoves();
+    }
+
+    void ExpectSameMoves( const std::vector< go::Move > & expected, const std::vector< go::Move > & moves )
+    {
+        ASSERT_EQ( expected.size(), moves.size() );
+        for ( unsigned i = 0; i < moves.size(); ++ i )
+        {
+            EXPECT_EQ( expected[i].type, moves[i].type ) << "move " << i;
+            if ( expected[i].type == go::MOVE_TYPE_PLACE )
+            {
+                EXPECT_EQ( expected[i].row, moves[i].row ) << "move " << i;
+                EXPECT_EQ( expected[i].column, moves[i].column ) << "move " << i;
+            }
+        }
+    }
+
+} // namespace
+
+TEST( ReplyCache, CachingEngine )
+{
+    const unsigned kBoardSize = 9;
+    const unsigned kLevel     = 1;
+    const unsigned kSeed      = 7;
+
+    CountingEngine engine( kLevel, kBoardSize );
+    gnugo::ReplyCache cache;
+    gnugo::CachingEngine cachingEngine( engine, cache, kSeed );
+
+    std::vector< go::Move > first = PlayGame( cachingEngine, kBoardSize );
+    unsigned genmoveCount = engine.GetGenmoveCount();
+    EXPECT_GT( genmoveCount, 0u );
+    EXPECT_EQ( cache.GetSize(), genmoveCount );
+
+    // The same game again is answered from the cache
+    ExpectSameMoves( first, PlayGame( cachingEngine, kBoardSize ) );
+    EXPECT_EQ( engine.GetGenmoveCount(), genmoveCount );
+
+    // And matches what the engine generates with the seed reset
+    gnugo::ReplyCache emptyCache;
+    gnugo::CachingEngine uncachedEngine( engine, emptyCache, kSeed );
+    ExpectSameMoves( first, PlayGame( uncachedEngine, kBoardSize ) );
+    EXPECT_EQ( engine.GetGenmoveCount(), genmoveCount * 2 );
+
+    // Saved and loaded
+    std::stringstream stream;
+    cache.Save( stream );
+    gnugo::ReplyCache loaded;
+    ASSERT_TRUE( loaded.Load( stream ) );
+    EXPECT_EQ( loaded.GetSize(), cache.GetSize() );
+
+    gnugo::CachingEngine loadedEngine( engine, loaded, kSeed );
+    ExpectSameMoves( first, PlayGame( loadedEngine, kBoardSize ) );
+    EXPECT_EQ( engine.GetGenmoveCount(), genmoveCount * 2 );
+}
@@ -0,0 +1,82 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "go/board.h"
+#include "go/scorer.h"
+
+namespace {
+
+    // Fills the board from rows of 'X' ( black ), 'O' ( white ) and '.'
+    void SetPosition( go::Board & board, const char * rows[] )
+    {
+        for ( unsigned row = 0; row < board.GetSize(); ++ row )
+        {
+            for ( unsigned column = 0; column < board.GetSize(); ++ column )
+            {
+                char c = rows[ row ][ column ];
+                board.Set( row, column,
+                    ( c == 'X' ) ? go::CELL_BLACK : ( c == 'O' ) ? go::CELL_WHITE : go::CELL_EMPTY );
+            }
+        }
+    }
+
+} // namespace
+
+TEST( Scorer, Empty )
+{
+    go::Board board( 9 );
+    go::Scorer scorer( 6.5f );
+    EXPECT_FLOAT_EQ( 6.5f, scorer.GetScore( board, go::COLOR_WHITE ) );
+    EXPECT_FLOAT_EQ( -6.5f, scorer.GetScore( board, go::COLOR_BLACK ) );
+}
+
+TEST( Scorer, Area )
+{
+    const char * rows[] = {
+        "..XO.....",
+        "..XO.....",
+        "..XO.....",
+        "..XO.....",
+        "..XO.....",
+        "..XO.....",
+        "..XO.....",
+        "..XO.....",
+        "..XO.....",
+    };
+
+    go::Board board( 9 );
+    SetPosition( board, rows );
+
+    go::Scorer scorer( 0.0f, go::SCORING_MODE_FAST );
+    EXPECT_FLOAT_EQ( 54.0f - 27.0f, scorer.GetScore( board, go::COLOR_WHITE ) );
+}
+
+TEST( Scorer, UnconditionalLife )
+{
+    // Black lives unconditionally with two eyes in the corner, so the white
+    // stone in one of them is dead; the other white stone is not
+    const char * rows[] = {
+        ".X.OX....",
+        "XXXXX....",
+        ".........",
+        ".........",
+        ".........",
+        ".....O...",
+        ".........",
+        ".........",
+        ".........",
+    };
+
+    go::Board board( 9 );
+    SetPosition( board, rows );
+
+    go::Scorer fast( 0.0f, go::SCORING_MODE_FAST );
+    EXPECT_FLOAT_EQ( 8.0f - 2.0f, fast.GetScore( board, go::COLOR_BLACK ) );
+
+    go::Scorer unconditional( 0.0f, go::SCORING_MODE_UNCONDITIONAL );
+    EXPECT_FLOAT_EQ( 10.0f - 1.0f, unconditional.GetScore( board, go::COLOR_BLACK ) );
+}
@@ -0,0 +1,47 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "go/symmetry.h"
+
+#include <set>
+#include <vector>
+
+TEST( Symmetry, Transforms )
+{
+    const unsigned kBoardSize = 5;
+    const unsigned kCellCount = kBoardSize * kBoardSize;
+
+    // A quarter turn takes the top left corner to the top right one
+    EXPECT_EQ( 0u, go::TransformPoint( 0, 0, kBoardSize ) );
+    EXPECT_EQ( kBoardSize - 1, go::TransformPoint( 1, 0, kBoardSize ) );
+    EXPECT_EQ( kCellCount - 1, go::TransformPoint( 2, 0, kBoardSize ) );
+    EXPECT_EQ( kBoardSize - 1, go::TransformPoint( 4, 0, kBoardSize ) );
+
+    // The centre stays put
+    for ( unsigned symmetry = 0; symmetry < go::kSymmetryCount; ++ symmetry )
+    {
+        EXPECT_EQ( kCellCount / 2, go::TransformPoint( symmetry, kCellCount / 2, kBoardSize ) );
+    }
+
+    // Every symmetry is a permutation of the points, and all of them differ
+    std::set< std::vector< unsigned > > permutations;
+    for ( unsigned symmetry = 0; symmetry < go::kSymmetryCount; ++ symmetry )
+    {
+        std::vector< unsigned > permutation;
+        std::set< unsigned > images;
+        for ( unsigned point = 0; point < kCellCount; ++ point )
+        {
+            unsigned image = go::TransformPoint( symmetry, point, kBoardSize );
+            ASSERT_LT( image, kCellCount );
+            images.insert( image );
+            permutation.push_back( image );
+        }
+        EXPECT_EQ( kCellCount, images.size() );
+        permutations.insert( permutation );
+    }
+    EXPECT_EQ( go::kSymmetryCount, permutations.size() );
+}
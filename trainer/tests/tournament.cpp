@@ -0,0 +1,69 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "cmn/thread_pool.h"
+#include "go/player_random.h"
+#include "training/tournament.h"
+
+#include <future>
+#include <numeric>
+
+namespace {
+
+    std::unique_ptr< go::IPlayer > MakeRandomPlayer( unsigned member, unsigned game )
+    {
+        return std::unique_ptr< go::IPlayer >( new go::PlayerRandom( member * 1000 + game ) );
+    }
+
+} // namespace
+
+TEST( Tournament, RoundRobin )
+{
+    const unsigned kMemberCount = 4;
+    const unsigned kBoardSize   = 7;
+
+    std::vector< double > expected;
+    {
+        Cmn::ThreadPool pool( 1 );
+        training::Tournament tournament( kMemberCount, kBoardSize, pool );
+        tournament.PlayRoundRobin( MakeRandomPlayer, 2 );
+        expected = tournament.GetRatings();
+
+        for ( unsigned member = 0; member < kMemberCount; ++ member )
+        {
+            EXPECT_EQ( 6u, tournament.GetGameCount( member ) );
+        }
+    }
+
+    // Elo is zero sum
+    EXPECT_DOUBLE_EQ( 1500.0 * kMemberCount, std::accumulate( expected.begin(), expected.end(), 0.0 ) );
+
+    // Same ratings whatever the number of threads
+    Cmn::ThreadPool pool( 4 );
+    training::Tournament tournament( kMemberCount, kBoardSize, pool );
+    tournament.PlayRoundRobin( MakeRandomPlayer, 2 );
+    EXPECT_EQ( expected, tournament.GetRatings() );
+}
+
+TEST( Tournament, SharedPool )
+{
+    const unsigned kMemberCount = 3;
+    const unsigned kBoardSize   = 7;
+
+    // A task of someone else keeps running through the whole round robin
+    Cmn::ThreadPool pool( 2 );
+    std::promise< void > release;
+    std::shared_future< void > released( release.get_future() );
+    pool.Submit( [ released ] { released.wait(); } );
+
+    training::Tournament tournament( kMemberCount, kBoardSize, pool );
+    tournament.PlayRoundRobin( MakeRandomPlayer, 2 );
+    EXPECT_EQ( 4u, tournament.GetGameCount( 0 ) );
+
+    release.set_value();
+    pool.Wait();
+}
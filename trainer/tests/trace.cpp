@@ -0,0 +1,74 @@
+#include "cmn/platform.h"
+
+CMN_WARNING_PUSH
+CMN_WARNING_DISABLE_MSVC( 4625 4626 )
+#include "gtest/gtest.h"
+CMN_WARNING_POP
+
+#include "cmn/trace.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST( Trace, AsyncLines )
+{
+    const unsigned kThreadCount = 4;
+    const unsigned kLineCount = 1000;
+
+    std::ostringstream output;
+    std::streambuf * consoleBuffer = std::cout.rdbuf( output.rdbuf() );
+    {
+        Cmn::AsyncTrace asyncTrace;
+
+        std::vector< std::thread > threads;
+        for ( unsigned thread = 0; thread < kThreadCount; ++ thread )
+        {
+            threads.emplace_back( [ thread ] {
+                for ( unsigned line = 0; line < kLineCount; line += 2 )
+                {
+                    CMN_MSG( "line %u %u", thread, line );
+                    CMN_MSG_DEFERRED( "line %u %u", thread, line + 1 );
+                }
+            } );
+        }
+
+        // Longer than a ring slot and the formatting buffer
+        CMN_MSG( "long %s", std::string( 3000, 'x' ).c_str() );
+
+        for ( auto & thread : threads )
+        {
+            thread.join();
+        }
+    }
+    std::cout.rdbuf( consoleBuffer );
+
+    std::vector< unsigned > nextLine( kThreadCount, 0 );
+    unsigned longCount = 0;
+
+    std::istringstream input( output.str() );
+    std::string text;
+    while ( std::getline( input, text ) )
+    {
+        if ( text.compare( 0, 5, "long " ) == 0 )
+        {
+            EXPECT_EQ( text, "long " + std::string( 3000, 'x' ) );
+            longCount ++;
+            continue;
+        }
+
+        unsigned thread = 0, line = 0;
+        ASSERT_EQ( std::sscanf( text.c_str(), "line %u %u", &thread, &line ), 2 ) << text;
+        ASSERT_LT( thread, kThreadCount );
+        EXPECT_EQ( line, nextLine[ thread ] );
+        nextLine[ thread ] = line + 1;
+    }
+
+    EXPECT_EQ( longCount, 1u );
+    for ( unsigned thread = 0; thread < kThreadCount; ++ thread )
+    {
+        EXPECT_EQ( nextLine[ thread ], kLineCount );
+    }
+}
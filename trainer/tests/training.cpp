@@ -6,8 +6,9 @@ CMN_WARNING_DISABLE_MSVC( 4625 4626 )
 CMN_WARNING_POP
 
 #include "ann/perceptron_genetic_algorithm_trainer.h"
-#include "gnugo/engine.h"
+#include "cmn/thread_pool.h"
 #include "gnugo/game.h"
+#include "gnugo/gtp_engine.h"
 #include "gnugo/player_ann.h"
 #include "gnugo/player_random.h"
 
@@ -20,7 +21,7 @@ double FitnessOp( ANN::ConstPerceptronIn nw )
 
     for ( unsigned i = 0; i < kGameCount; ++ i )
     {
-        gnugo::Engine       engine( 1, kBoardSize );
+        gnugo::GtpEngine    engine( 1, kBoardSize );
         gnugo::PlayerAnn    blackPlayer( nw, engine );
         gnugo::PlayerRandom whitePlayer( engine, i );
         gnugo::Game         game( kBoardSize, blackPlayer, whitePlayer, engine );
@@ -35,7 +36,8 @@ double FitnessOp( ANN::ConstPerceptronIn nw )
 
 TEST( LS, TrainingIteration )
 {
+    Cmn::ThreadPool pool;
     ANN::IPerceptronGeneticAlgorithmTrainerRef trainer =
-        ANN::CreatePerceptronGeneticAlgorithmTrainer( FitnessOp, 81, 82, 3 );
+        ANN::CreatePerceptronGeneticAlgorithmTrainer( FitnessOp, 81, 82, 3, pool );
     trainer->Step();
 }
@@ -0,0 +1,171 @@
+#include "cmn/platform.h"
+#include "cmn/trace.h"
+#include "training/checkpointer.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#if CMN_WIN32
+    #include <io.h>
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace training {
+
+    Checkpointer::Checkpointer( const std::string & path )
+        : mPath( path )
+        , mHasPending( false )
+        , mWriting( false )
+        , mFailed( false )
+        , mStop( false )
+    {
+        mWriter = std::thread( &Checkpointer::WriterMain, this );
+    }
+
+    Checkpointer::~Checkpointer()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mStop = true;
+        }
+        mSnapshotReady.notify_one();
+        mWriter.join();
+    }
+
+    void Checkpointer::Save( std::string snapshot )
+    {
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mPending.swap( snapshot );
+            mHasPending = true;
+        }
+        mSnapshotReady.notify_one();
+    }
+
+    bool Checkpointer::Wait()
+    {
+        std::unique_lock< std::mutex > lock( mMutex );
+        mSnapshotWritten.wait( lock, [ this ] { return !mHasPending && !mWriting; } );
+
+        bool succeeded = !mFailed;
+        mFailed = false;
+        return succeeded;
+    }
+
+    bool Checkpointer::Load( std::string & snapshot ) const
+    {
+        std::ifstream stream( mPath.c_str(), std::ios::in | std::ios::binary );
+        if ( !stream.is_open() )
+        {
+            return false;
+        }
+
+        std::ostringstream contents;
+        contents << stream.rdbuf();
+        snapshot = contents.str();
+        return !stream.bad();
+    }
+
+    // Forces the file's contents to disk, so that a crash after the rename
+    // can't leave the checkpoint pointing at data that was never written
+    static bool SyncFile( std::FILE * file )
+    {
+    #if CMN_WIN32
+        return _commit( _fileno( file ) ) == 0;
+    #else
+        return fsync( fileno( file ) ) == 0;
+    #endif
+    }
+
+    // Forces the rename itself to disk
+    static bool SyncDirectory( const std::string & path )
+    {
+    #if CMN_WIN32
+        CMN_UNUSED( path );
+        return true; // MOVEFILE_WRITE_THROUGH
+    #else
+        size_t separator = path.find_last_of( '/' );
+        std::string directory = ( separator == std::string::npos ) ? "." :
+                                ( separator == 0 ) ? "/" : path.substr( 0, separator );
+
+        int fd = open( directory.c_str(), O_RDONLY );
+        if ( fd < 0 )
+        {
+            return false;
+        }
+        bool synced = fsync( fd ) == 0;
+        close( fd );
+        return synced;
+    #endif
+    }
+
+    bool Checkpointer::Write( const std::string & snapshot )
+    {
+        std::string temporaryPath = mPath + ".tmp";
+
+        std::FILE * file = std::fopen( temporaryPath.c_str(), "wb" );
+        bool written = file != nullptr &&
+                       std::fwrite( snapshot.data(), 1, snapshot.size(), file ) == snapshot.size() &&
+                       std::fflush( file ) == 0 &&
+                       SyncFile( file );
+        if ( file != nullptr && std::fclose( file ) != 0 )
+        {
+            written = false;
+        }
+        if ( !written )
+        {
+            CMN_ERR( "Can't write checkpoint %s", temporaryPath.c_str() );
+            return false;
+        }
+
+    #if CMN_WIN32
+        BOOL renamed = MoveFileExA( temporaryPath.c_str(), mPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH );
+        if ( !renamed )
+    #else
+        if ( std::rename( temporaryPath.c_str(), mPath.c_str() ) != 0 )
+    #endif
+        {
+            CMN_ERR( "Can't replace checkpoint %s", mPath.c_str() );
+            return false;
+        }
+
+        if ( !SyncDirectory( mPath ) )
+        {
+            CMN_ERR( "Can't sync the directory of checkpoint %s", mPath.c_str() );
+            return false;
+        }
+
+        return true;
+    }
+
+    void Checkpointer::WriterMain()
+    {
+        std::unique_lock< std::mutex > lock( mMutex );
+        while ( true )
+        {
+            mSnapshotReady.wait( lock, [ this ] { return mHasPending || mStop; } );
+            if ( !mHasPending )
+            {
+                return;
+            }
+
+            std::string snapshot;
+            snapshot.swap( mPending );
+            mHasPending = false;
+            mWriting    = true;
+            lock.unlock();
+
+            bool written = Write( snapshot );
+
+            lock.lock();
+            mWriting    = false;
+            mFailed     = mFailed || !written;
+            mSnapshotWritten.notify_all();
+        }
+    }
+
+} // namespace training
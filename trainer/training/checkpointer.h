@@ -0,0 +1,63 @@
+#ifndef __TRAINING_CHECKPOINTER_H__
+#define __TRAINING_CHECKPOINTER_H__
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace training {
+
+    // Keeps one file up to date with the latest snapshot handed to Save().
+    // Snapshots arrive already serialised, so the caller's state can move
+    // on at once; a background thread writes each one to a temporary file,
+    // syncs it and renames it over the checkpoint, so the file on disk is
+    // always a complete snapshot, even after a power loss. If snapshots come faster than the disk takes them,
+    // only the newest waiting one is written.
+
+    class Checkpointer
+    {
+    public:
+        void
+        Save( std::string snapshot );
+
+        // Blocks until the last snapshot saved is on disk; false if writing
+        // any snapshot failed
+        bool
+        Wait();
+
+        // Reads the checkpoint; false if there is none
+        bool
+        Load( std::string & snapshot ) const;
+
+        const std::string &
+        GetPath() const { return mPath; }
+
+    public:
+        Checkpointer( const std::string & path );
+        ~Checkpointer();
+
+    private:
+        bool
+        Write( const std::string & snapshot );
+
+        void
+        WriterMain();
+
+    private:
+        std::string                 mPath;
+
+        std::mutex                  mMutex;
+        std::condition_variable     mSnapshotReady;
+        std::condition_variable     mSnapshotWritten;
+        std::string                 mPending;
+        bool                        mHasPending;
+        bool                        mWriting;
+        bool                        mFailed;
+        bool                        mStop;
+        std::thread                 mWriter;
+    };
+
+} // namespace training
+
+#endif // __TRAINING_CHECKPOINTER_H__
@@ -0,0 +1,141 @@
+#include "ann/perceptron.h"
+#include "training/fitness_cache.h"
+
+#include <cstring>
+
+namespace training {
+
+    static const uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+    static const uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+
+    static uint64_t Rotate( uint64_t value, unsigned bits )
+    {
+        return ( value << bits ) | ( value >> ( 64 - bits ) );
+    }
+
+    uint64_t FitnessCache::Hash( const void * data, size_t size, uint64_t seed /* = 0 */ )
+    {
+        const uint8_t * bytes = static_cast< const uint8_t * >( data );
+
+        uint64_t hash = seed ^ ( size * kPrime1 );
+        for ( ; size >= 8; size -= 8, bytes += 8 )
+        {
+            uint64_t word;
+            std::memcpy( &word, bytes, 8 );
+            hash = Rotate( hash ^ ( word * kPrime2 ), 31 ) * kPrime1;
+        }
+
+        uint64_t tail = 0;
+        std::memcpy( &tail, bytes, size );
+        hash = Rotate( hash ^ ( tail * kPrime2 ), 31 ) * kPrime1;
+
+        // Finaliser, so that every input bit reaches every output bit
+        hash ^= hash >> 33;
+        hash *= kPrime2;
+        hash ^= hash >> 29;
+        hash *= kPrime1;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    uint64_t FitnessCache::GetKey( const ANN::Perceptron & perceptron, uint64_t configuration )
+    {
+        const std::vector< double > & weights = perceptron.GetWeights();
+        uint64_t shape = ( static_cast< uint64_t >( perceptron.GetInputsCount() ) << 32 ) | perceptron.GetOutputsCount();
+        return Hash( weights.data(), weights.size() * sizeof( double ), configuration ^ ( shape * kPrime1 ) );
+    }
+
+    FitnessCache::FitnessCache( size_t capacity )
+        : mCapacity( capacity )
+    {
+    }
+
+    FitnessCache::~FitnessCache()
+    {
+    }
+
+    bool FitnessCache::Find( uint64_t key, double & fitness )
+    {
+        std::lock_guard< std::mutex > lock( mMutex );
+
+        auto found = mIndex.find( key );
+        if ( found == mIndex.end() )
+        {
+            return false;
+        }
+
+        mEntries.splice( mEntries.begin(), mEntries, found->second );
+        fitness = found->second->second;
+        return true;
+    }
+
+    void FitnessCache::Insert( uint64_t key, double fitness )
+    {
+        std::lock_guard< std::mutex > lock( mMutex );
+
+        if ( mCapacity == 0 )
+        {
+            return;
+        }
+
+        auto found = mIndex.find( key );
+        if ( found != mIndex.end() )
+        {
+            found->second->second = fitness;
+            mEntries.splice( mEntries.begin(), mEntries, found->second );
+            return;
+        }
+
+        if ( mEntries.size() >= mCapacity )
+        {
+            mIndex.erase( mEntries.back().first );
+            mEntries.pop_back();
+        }
+
+        mEntries.emplace_front( key, fitness );
+        mIndex[ key ] = mEntries.begin();
+    }
+
+    size_t FitnessCache::GetSize() const
+    {
+        std::lock_guard< std::mutex > lock( mMutex );
+        return mEntries.size();
+    }
+
+    void FitnessCache::Save( std::ostream & stream ) const
+    {
+        std::lock_guard< std::mutex > lock( mMutex );
+
+        uint64_t count = mEntries.size();
+        stream.write( reinterpret_cast< const char * >( &count ), sizeof( count ) );
+        for ( auto entry = mEntries.rbegin(); entry != mEntries.rend(); ++ entry )
+        {
+            stream.write( reinterpret_cast< const char * >( &entry->first ), sizeof( entry->first ) );
+            stream.write( reinterpret_cast< const char * >( &entry->second ), sizeof( entry->second ) );
+        }
+    }
+
+    bool FitnessCache::Load( std::istream & stream )
+    {
+        uint64_t count = 0;
+        if ( !stream.read( reinterpret_cast< char * >( &count ), sizeof( count ) ) )
+        {
+            return false;
+        }
+
+        for ( uint64_t i = 0; i < count; ++ i )
+        {
+            uint64_t key = 0;
+            double fitness = 0.0;
+            if ( !stream.read( reinterpret_cast< char * >( &key ), sizeof( key ) ) ||
+                 !stream.read( reinterpret_cast< char * >( &fitness ), sizeof( fitness ) ) )
+            {
+                return false;
+            }
+            Insert( key, fitness );
+        }
+
+        return true;
+    }
+
+} // namespace training
@@ -0,0 +1,73 @@
+#ifndef __TRAINING_FITNESS_CACHE_H__
+#define __TRAINING_FITNESS_CACHE_H__
+
+#include "ann/types_fwd.h"
+
+#include <cstdint>
+#include <istream>
+#include <list>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+
+namespace training {
+
+    // Fitness of networks already evaluated, keyed by a hash of their
+    // weights and of the evaluation settings, so that elites and children
+    // left unchanged by mutation aren't played again. Holds up to a
+    // capacity of entries, dropping the least recently used one beyond.
+    //
+    // Only worth it when an evaluation always gives the same fitness for
+    // the same network, as games against a seeded engine do; otherwise a
+    // lucky evaluation sticks.
+
+    class FitnessCache
+    {
+    public:
+        // 64 bit hash of a buffer, a word at a time
+        static uint64_t
+        Hash( const void * data, size_t size, uint64_t seed = 0 );
+
+        // Key of a network under evaluation settings hashed into
+        // configuration
+        static uint64_t
+        GetKey( const ANN::Perceptron &, uint64_t configuration );
+
+        // Makes the entry the most recently used one
+        bool
+        Find( uint64_t key, double & fitness );
+
+        void
+        Insert( uint64_t key, double fitness );
+
+        size_t
+        GetSize() const;
+
+        // Entries from the least to the most recently used one, so that a
+        // loaded cache evicts in the same order
+        void
+        Save( std::ostream & ) const;
+
+        // Adds the entries of a saved cache; false if it is malformed
+        bool
+        Load( std::istream & );
+
+    public:
+        FitnessCache( size_t capacity );
+        ~FitnessCache();
+
+    private:
+        typedef std::pair< uint64_t, double >   Entry;
+        typedef std::list< Entry >              Entries;
+
+        size_t                                              mCapacity;
+
+        mutable std::mutex                                  mMutex;
+        Entries                                             mEntries;   // most recently used first
+        std::unordered_map< uint64_t, Entries::iterator >   mIndex;
+    };
+
+} // namespace training
+
+#endif // __TRAINING_FITNESS_CACHE_H__
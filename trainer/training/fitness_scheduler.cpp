@@ -0,0 +1,156 @@
+#include "cmn/thread_pool.h"
+#include "cmn/trace.h"
+#include "training/fitness_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace training {
+
+    FitnessScheduler::FitnessScheduler( Cmn::ThreadPool & pool )
+        : mPool( pool )
+    {
+    }
+
+    FitnessScheduler::~FitnessScheduler()
+    {
+    }
+
+    void FitnessScheduler::Evaluate( unsigned individualCount, unsigned gameCount,
+                                     const GameOp & gameOp, std::vector< double > & fitness )
+    {
+        mScores.assign( individualCount * gameCount, 0.0 );
+
+        // Games interleaved across individuals, so that stealing from the
+        // front of a queue spreads individuals over the threads
+        for ( unsigned game = 0; game < gameCount; ++ game )
+        {
+            for ( unsigned individual = 0; individual < individualCount; ++ individual )
+            {
+                double * score = &mScores[ individual * gameCount + game ];
+                mPool.Submit( [ &gameOp, score, individual, game ] {
+                    *score = gameOp( individual, game );
+                } );
+            }
+        }
+
+        mPool.Wait();
+
+        fitness.resize( individualCount );
+        for ( unsigned individual = 0; individual < individualCount; ++ individual )
+        {
+            double sum = 0.0;
+            for ( unsigned game = 0; game < gameCount; ++ game )
+            {
+                sum += mScores[ individual * gameCount + game ];
+            }
+            fitness[ individual ] = ( gameCount > 0 ) ? sum / gameCount : 0.0;
+        }
+    }
+
+    unsigned FitnessScheduler::EvaluateRacing( unsigned individualCount, unsigned maxGameCount,
+                                               const RacingOptions & options, const GameOp & gameOp,
+                                               std::vector< double > & fitness )
+    {
+        CMN_ASSERT( options.eliteCount > 0 );
+
+        mScores.assign( individualCount * maxGameCount, 0.0 );
+        mPlayed.assign( individualCount, 0 );
+        mRacing.assign( individualCount, true );
+        mLowerBounds.assign( individualCount, 0.0 );
+        fitness.assign( individualCount, 0.0 );
+
+        unsigned roundGameCount = std::max( options.roundGameCount, 1u );
+        unsigned totalGameCount = 0;
+
+        while ( true )
+        {
+            // Next round of the individuals still in, interleaved as above.
+            // They all have played as many games.
+            unsigned played = 0;
+            for ( unsigned individual = 0; individual < individualCount; ++ individual )
+            {
+                if ( mRacing[ individual ] )
+                {
+                    played = mPlayed[ individual ];
+                }
+            }
+            unsigned roundEnd = std::min( played + roundGameCount, maxGameCount );
+
+            unsigned submitted = 0;
+            for ( unsigned game = played; game < roundEnd; ++ game )
+            {
+                for ( unsigned individual = 0; individual < individualCount; ++ individual )
+                {
+                    if ( mRacing[ individual ] )
+                    {
+                        double * score = &mScores[ individual * maxGameCount + game ];
+                        mPool.Submit( [ &gameOp, score, individual, game ] {
+                            *score = gameOp( individual, game );
+                        } );
+                        submitted ++;
+                    }
+                }
+            }
+
+            if ( submitted == 0 )
+            {
+                break;
+            }
+
+            mPool.Wait();
+            totalGameCount += submitted;
+
+            // Means, summed in game order, and bounds
+            mUpperBounds.clear();
+            for ( unsigned individual = 0; individual < individualCount; ++ individual )
+            {
+                if ( !mRacing[ individual ] )
+                {
+                    continue;
+                }
+
+                mPlayed[ individual ] = roundEnd;
+                const double * scores = &mScores[ individual * maxGameCount ];
+
+                double sum = 0.0;
+                for ( unsigned game = 0; game < roundEnd; ++ game )
+                {
+                    sum += scores[ game ];
+                }
+                double mean = sum / roundEnd;
+
+                double squares = 0.0;
+                for ( unsigned game = 0; game < roundEnd; ++ game )
+                {
+                    squares += ( scores[ game ] - mean ) * ( scores[ game ] - mean );
+                }
+                double deviation = ( roundEnd > 1 ) ? std::sqrt( squares / ( roundEnd - 1 ) ) : 0.0;
+                deviation = std::max( deviation, options.minDeviation );
+                double margin = options.confidence * deviation / std::sqrt( static_cast< double >( roundEnd ) );
+
+                fitness[ individual ] = mean;
+                mLowerBounds[ individual ] = mean - margin;
+                mUpperBounds.push_back( mean + margin );
+            }
+
+            if ( mUpperBounds.size() <= options.eliteCount )
+            {
+                continue;
+            }
+
+            std::nth_element( mUpperBounds.begin(), mUpperBounds.begin() + options.eliteCount - 1, mUpperBounds.end() );
+            double threshold = mUpperBounds[ options.eliteCount - 1 ];
+            for ( unsigned individual = 0; individual < individualCount; ++ individual )
+            {
+                if ( mRacing[ individual ] && mLowerBounds[ individual ] > threshold )
+                {
+                    mRacing[ individual ] = false;
+                }
+            }
+        }
+
+        return totalGameCount;
+    }
+
+} // namespace training
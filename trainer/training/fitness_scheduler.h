@@ -0,0 +1,83 @@
+#ifndef __TRAINING_FITNESS_SCHEDULER_H__
+#define __TRAINING_FITNESS_SCHEDULER_H__
+
+#include <functional>
+#include <vector>
+
+namespace Cmn {
+    class ThreadPool;
+}
+
+namespace training {
+
+    // Evaluates a whole generation as one set of tasks: every game of every
+    // individual is a task of its own on a work stealing pool, so threads
+    // keep busy until the generation's last game. Game scores are written
+    // to their own slots and summed in game order afterwards, so fitness
+    // doesn't depend on how the games were scheduled.
+
+    class FitnessScheduler
+    {
+    public:
+        // Plays one game of an individual and returns its score
+        typedef std::function< double( unsigned individual, unsigned game ) > GameOp;
+
+        // Racing: the games are played in rounds, and after each round the
+        // individuals that can no longer be among the eliteCount fittest
+        // stop playing. An individual is out once the lower bound of its
+        // mean score is above the eliteCount-th lowest upper bound of the
+        // others still in, the bounds being the mean plus or minus
+        // confidence standard errors.
+        struct RacingOptions
+        {
+            unsigned    eliteCount;
+            unsigned    roundGameCount;
+            double      confidence;
+
+            // Floor of the score deviation, so that a few equal scores
+            // don't make for a certain mean
+            double      minDeviation;
+
+            RacingOptions( unsigned eliteCount_ )
+                : eliteCount( eliteCount_ )
+                , roundGameCount( 5 )
+                , confidence( 2.0 )
+                , minDeviation( 1.0 )
+            {}
+        };
+
+        // Fills the mean game score of each individual
+        void
+        Evaluate( unsigned individualCount, unsigned gameCount,
+                  const GameOp &, std::vector< double > & fitness );
+
+        // Same, racing the individuals: up to maxGameCount games each, the
+        // fitness of an individual dropped early being the mean of the
+        // games it played. Returns the number of games played.
+        unsigned
+        EvaluateRacing( unsigned individualCount, unsigned maxGameCount, const RacingOptions &,
+                        const GameOp &, std::vector< double > & fitness );
+
+        // Games an individual played in the last EvaluateRacing(); below
+        // maxGameCount its fitness is a partial mean
+        unsigned
+        GetPlayedGameCount( unsigned individual ) const { return mPlayed[ individual ]; }
+
+    public:
+        FitnessScheduler( Cmn::ThreadPool & );
+        ~FitnessScheduler();
+
+    private:
+        Cmn::ThreadPool &       mPool;
+        std::vector< double >   mScores;
+
+        // Of EvaluateRacing()
+        std::vector< unsigned > mPlayed;
+        std::vector< bool >     mRacing;
+        std::vector< double >   mLowerBounds;
+        std::vector< double >   mUpperBounds;
+    };
+
+} // namespace training
+
+#endif // __TRAINING_FITNESS_SCHEDULER_H__
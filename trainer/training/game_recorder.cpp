@@ -0,0 +1,178 @@
+#include "cmn/platform.h"
+#include "cmn/trace.h"
+#include "training/game_recorder.h"
+
+#if CMN_WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace training {
+
+    static bool Truncate( const std::string & path, std::streamoff size )
+    {
+    #if CMN_WIN32
+        HANDLE file = CreateFileA( path.c_str(), GENERIC_WRITE, 0, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+        if ( file == INVALID_HANDLE_VALUE )
+        {
+            return false;
+        }
+
+        LARGE_INTEGER offset;
+        offset.QuadPart = size;
+        BOOL truncated = SetFilePointerEx( file, offset, 0, FILE_BEGIN ) && SetEndOfFile( file );
+        CloseHandle( file );
+        return truncated != FALSE;
+    #else
+        return truncate( path.c_str(), static_cast< off_t >( size ) ) == 0;
+    #endif
+    }
+
+    // A crash can leave the last record half written, and records appended
+    // after it would be unreadable. Cuts the log back to its last complete
+    // record; returns false if the file isn't a game log.
+    static bool Recover( const std::string & path )
+    {
+        std::streamoff complete = 0;
+        std::streamoff size     = 0;
+
+        {
+            std::ifstream stream( path.c_str(), std::ios::in | std::ios::binary );
+            if ( !stream.is_open() )
+            {
+                return true;
+            }
+
+            stream.seekg( 0, std::ios::end );
+            size = stream.tellg();
+            stream.seekg( 0, std::ios::beg );
+
+            go::GameRecordReader reader( stream );
+            if ( reader.IsValid() )
+            {
+                complete = stream.tellg();
+                while ( reader.Skip() )
+                {
+                    complete = stream.tellg();
+                }
+            }
+            else if ( size >= static_cast< std::streamoff >( sizeof( go::kGameRecordMagic ) ) )
+            {
+                return false;
+            }
+        }
+
+        if ( complete == size )
+        {
+            return true;
+        }
+
+        CMN_MSG( "Dropping %lld bytes of a torn record from game log %s",
+            static_cast< long long >( size - complete ), path.c_str() );
+        return Truncate( path, complete );
+    }
+
+    GameRecorder::GameRecorder( const std::string & path, size_t bufferSize /* = 1 << 20 */ )
+        : mBufferSize( bufferSize )
+        , mWriting( false )
+        , mFlushRequested( false )
+        , mStop( false )
+    {
+        if ( Recover( path ) )
+        {
+            mFile.open( path.c_str(), std::ios::out | std::ios::binary | std::ios::app );
+        }
+
+        if ( !mFile.is_open() )
+        {
+            CMN_ERR( "Can't open game log %s", path.c_str() );
+        }
+        else if ( mFile.tellp() == std::streampos( 0 ) )
+        {
+            mFile.write( go::kGameRecordMagic, sizeof( go::kGameRecordMagic ) );
+        }
+
+        mBuffer.reserve( mBufferSize );
+        mWriteBuffer.reserve( mBufferSize );
+        mWriter = std::thread( &GameRecorder::WriterMain, this );
+    }
+
+    GameRecorder::~GameRecorder()
+    {
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            mStop = true;
+        }
+        mBufferReady.notify_one();
+        mWriter.join();
+    }
+
+    void GameRecorder::Record( const go::GameRecord & record )
+    {
+        std::unique_lock< std::mutex > lock( mMutex );
+        go::EncodeGameRecord( record, mBuffer );
+
+        if ( mBuffer.size() >= mBufferSize )
+        {
+            // Hand the buffer over, waiting only if the writer is still busy
+            // with the previous one
+            mBufferWritten.wait( lock, [ this ] { return !mWriting; } );
+            mBuffer.swap( mWriteBuffer );
+            mWriting = true;
+            lock.unlock();
+            mBufferReady.notify_one();
+        }
+    }
+
+    void GameRecorder::Flush()
+    {
+        std::unique_lock< std::mutex > lock( mMutex );
+        mBufferWritten.wait( lock, [ this ] { return !mWriting; } );
+        mBuffer.swap( mWriteBuffer );
+        mWriting        = true;
+        mFlushRequested = true;
+        mBufferReady.notify_one();
+        mBufferWritten.wait( lock, [ this ] { return !mWriting; } );
+    }
+
+    void GameRecorder::WriterMain()
+    {
+        std::unique_lock< std::mutex > lock( mMutex );
+        while ( true )
+        {
+            mBufferReady.wait( lock, [ this ] { return mWriting || mStop; } );
+
+            if ( !mWriting )
+            {
+                // Stopping: the rest of the records go out from here
+                mBuffer.swap( mWriteBuffer );
+            }
+
+            bool flush = mFlushRequested || mStop;
+            mFlushRequested = false;
+            lock.unlock();
+
+            if ( mFile.is_open() && !mWriteBuffer.empty() )
+            {
+                mFile.write( reinterpret_cast< const char * >( mWriteBuffer.data() ), mWriteBuffer.size() );
+            }
+            if ( mFile.is_open() && flush )
+            {
+                mFile.flush();
+            }
+            mWriteBuffer.clear();
+
+            lock.lock();
+            bool wasWriting = mWriting;
+            mWriting = false;
+            mBufferWritten.notify_all();
+
+            if ( mStop && !wasWriting )
+            {
+                return;
+            }
+        }
+    }
+
+} // namespace training
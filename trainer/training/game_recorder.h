@@ -0,0 +1,58 @@
+#ifndef __TRAINING_GAME_RECORDER_H__
+#define __TRAINING_GAME_RECORDER_H__
+
+#include "go/game_record.h"
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace training {
+
+    // Appends game records to a log file from any thread. Records are
+    // encoded into a memory buffer; a background thread writes a full
+    // buffer out while the next one fills, so games never wait on disk.
+    // Opening an existing log cuts off a record torn by a crash.
+
+    class GameRecorder
+    {
+    public:
+        void
+        Record( const go::GameRecord & );
+
+        // Blocks until everything recorded so far is written
+        void
+        Flush();
+
+        bool
+        IsOpen() const { return mFile.is_open(); }
+
+    public:
+        GameRecorder( const std::string & path, size_t bufferSize = 1 << 20 );
+        ~GameRecorder();
+
+    private:
+        void
+        WriterMain();
+
+    private:
+        std::ofstream               mFile;
+        size_t                      mBufferSize;
+
+        std::mutex                  mMutex;
+        std::condition_variable     mBufferReady;
+        std::condition_variable     mBufferWritten;
+        std::vector< uint8_t >      mBuffer;
+        std::vector< uint8_t >      mWriteBuffer;
+        bool                        mWriting;
+        bool                        mFlushRequested;
+        bool                        mStop;
+        std::thread                 mWriter;
+    };
+
+} // namespace training
+
+#endif // __TRAINING_GAME_RECORDER_H__
@@ -0,0 +1,179 @@
+#include "ann/perceptron.h"
+#include "gnugo/caching_engine.h"
+#include "gnugo/engine_pool.h"
+#include "gnugo/game.h"
+#include "gnugo/native_engine.h"
+#include "gnugo/player.h"
+#include "gnugo/player_ann.h"
+#include "go/scorer.h"
+#include "training/fitness_cache.h"
+#include "training/fitness_scheduler.h"
+#include "training/game_recorder.h"
+#include "training/generation_evaluator.h"
+#include "training/inference_batcher.h"
+
+#include <memory>
+#include <string>
+
+namespace training {
+
+    // Longest a move waits for its batch to fill
+    static const std::chrono::microseconds kInferenceDelay( 200 );
+
+    // A native engine belongs to the thread that made it, and there can be
+    // one per thread, so each thread keeps its own between games
+    static gnugo::NativeEngine & GetThreadNativeEngine( unsigned level, unsigned boardSize )
+    {
+        static thread_local std::unique_ptr< gnugo::NativeEngine > sEngine;
+        if ( !sEngine || sEngine->GetLevel() != level || sEngine->GetBoardSize() != boardSize )
+        {
+            sEngine.reset();
+            sEngine.reset( new gnugo::NativeEngine( level, boardSize ) );
+        }
+        return *sEngine;
+    }
+
+    GenerationEvaluator::GenerationEvaluator( const Settings & settings, FitnessScheduler & scheduler,
+                                              gnugo::EnginePool & enginePool, gnugo::ReplyCache & replyCache )
+        : mSettings( settings )
+        , mConfiguration( 0 )
+        , mScheduler( scheduler )
+        , mEnginePool( enginePool )
+        , mReplyCache( replyCache )
+        , mFitnessCache( nullptr )
+        , mGameRecorder( nullptr )
+    {
+        std::vector< unsigned > values = {
+            mSettings.boardSize, mSettings.level, mSettings.gameCount, mSettings.roundGameCount };
+        for ( unsigned game = 0; game < mSettings.gameCount; ++ game )
+        {
+            values.push_back( GetGameSeed( game ) );
+        }
+        mConfiguration = FitnessCache::Hash( values.data(), values.size() * sizeof( unsigned ) );
+    }
+
+    GenerationEvaluator::~GenerationEvaluator()
+    {
+    }
+
+    double GenerationEvaluator::PlayGame( ANN::ConstPerceptronIn nw, unsigned game )
+    {
+        return PlayGame( nw, game, nullptr );
+    }
+
+    double GenerationEvaluator::PlayGame( ANN::ConstPerceptronIn nw, unsigned game, InferenceBatcher * batcher )
+    {
+        std::shared_ptr< gnugo::GtpEngine > processEngine;
+        gnugo::Engine * engine = nullptr;
+        if ( mSettings.nativeEngine )
+        {
+            engine = &GetThreadNativeEngine( mSettings.level, mSettings.boardSize );
+        }
+        else
+        {
+            processEngine = mEnginePool.Acquire( mSettings.level, mSettings.boardSize );
+            engine = processEngine.get();
+        }
+
+        gnugo::CachingEngine cachingEngine( *engine, mReplyCache, GetGameSeed( game ) );
+        gnugo::PlayerAnn     blackPlayer( nw, cachingEngine, batcher );
+        gnugo::Player        whitePlayer( cachingEngine );
+        gnugo::Game          goGame( mSettings.boardSize, blackPlayer, whitePlayer, cachingEngine );
+        goGame.Play();
+
+        go::Scorer           scorer;
+        float                score = scorer.GetScore( goGame.GetBoard(), go::COLOR_WHITE );
+
+        if ( mGameRecorder != nullptr )
+        {
+            go::GameRecord   record;
+            record.boardSize    = mSettings.boardSize;
+            record.blackPlayer  = "ann";
+            record.whitePlayer  = "gnugo-" + std::to_string( mSettings.level );
+            record.seed         = GetGameSeed( game );
+            record.score        = score;
+            record.moves        = goGame.GetMoves();
+            mGameRecorder->Record( record );
+        }
+
+        return score;
+    }
+
+    unsigned GenerationEvaluator::Evaluate( const std::vector< ANN::ConstPerceptronRef > & generation, unsigned eliteCount,
+                                            std::vector< double > & fitness )
+    {
+        // Only the networks the cache doesn't know are played
+        unsigned individualCount = static_cast< unsigned >( generation.size() );
+        fitness.resize( individualCount );
+
+        std::vector< uint64_t > keys( individualCount );
+        std::vector< unsigned > unknown;
+        for ( unsigned individual = 0; individual < individualCount; ++ individual )
+        {
+            if ( mFitnessCache != nullptr )
+            {
+                keys[ individual ] = FitnessCache::GetKey( *generation[ individual ], mConfiguration );
+                if ( mFitnessCache->Find( keys[ individual ], fitness[ individual ] ) )
+                {
+                    continue;
+                }
+            }
+            unknown.push_back( individual );
+        }
+
+        unsigned unknownCount = static_cast< unsigned >( unknown.size() );
+        if ( unknownCount == 0 )
+        {
+            return 0;
+        }
+
+        // One batcher per network, shared by the games it plays at once
+        std::vector< std::unique_ptr< InferenceBatcher > > batchers( unknownCount );
+        if ( mSettings.inferenceBatchSize > 0 )
+        {
+            for ( unsigned i = 0; i < unknownCount; ++ i )
+            {
+                const ANN::Perceptron & network = *generation[ unknown[i] ];
+                batchers[i].reset( new InferenceBatcher( network.GetInputsCount(), network.GetOutputsCount(),
+                    InferenceBatcher::Batched( generation[ unknown[i] ] ), mSettings.inferenceBatchSize, kInferenceDelay ) );
+            }
+        }
+
+        auto gameOp = [ this, &generation, &unknown, &batchers ] ( unsigned individual, unsigned game ) {
+            return PlayGame( generation[ unknown[ individual ] ], game, batchers[ individual ].get() );
+        };
+
+        unsigned gameCount = unknownCount * mSettings.gameCount;
+        std::vector< double > unknownFitness;
+        std::vector< bool > complete( unknownCount, true );
+        if ( mSettings.roundGameCount == 0 || eliteCount == 0 )
+        {
+            mScheduler.Evaluate( unknownCount, mSettings.gameCount, gameOp, unknownFitness );
+        }
+        else
+        {
+            FitnessScheduler::RacingOptions options( eliteCount );
+            options.roundGameCount = mSettings.roundGameCount;
+            gameCount = mScheduler.EvaluateRacing( unknownCount, mSettings.gameCount, options, gameOp, unknownFitness );
+
+            for ( unsigned i = 0; i < unknownCount; ++ i )
+            {
+                complete[i] = mScheduler.GetPlayedGameCount( i ) == mSettings.gameCount;
+            }
+        }
+
+        // The mean of a dropped individual depends on whom it raced against,
+        // only the fitness of all the games is the network's own
+        for ( unsigned i = 0; i < unknownCount; ++ i )
+        {
+            fitness[ unknown[i] ] = unknownFitness[i];
+            if ( complete[i] && mFitnessCache != nullptr )
+            {
+                mFitnessCache->Insert( keys[ unknown[i] ], unknownFitness[i] );
+            }
+        }
+
+        return gameCount;
+    }
+
+} // namespace training
@@ -0,0 +1,111 @@
+#ifndef __TRAINING_GENERATION_EVALUATOR_H__
+#define __TRAINING_GENERATION_EVALUATOR_H__
+
+#include "ann/types_fwd.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace gnugo {
+    class EnginePool;
+    class ReplyCache;
+}
+
+namespace training {
+
+    class FitnessCache;
+    class FitnessScheduler;
+    class GameRecorder;
+    class InferenceBatcher;
+
+    // Fitness of a generation the way the trainer measures it: every game
+    // pits a network playing black against GNU Go, restarted from a seed of
+    // its own, through the reply cache, and is scored by go::Scorer. GNU Go
+    // runs either in processes from the engine pool or in the trainer
+    // itself, see Settings::nativeEngine. The fitness cache skips the
+    // networks evaluated before, and the rest race for the elite unless
+    // racing is off.
+
+    class GenerationEvaluator
+    {
+    public:
+        struct Settings
+        {
+            unsigned    boardSize;
+            unsigned    level;
+            unsigned    gameCount;
+
+            // Games of a racing round; zero plays every game of everyone
+            unsigned    roundGameCount;
+
+            // Game i restarts GNU Go with seed + i
+            unsigned    seed;
+
+            // GNU Go linked in, one engine kept by each thread that plays,
+            // instead of GNU Go processes from the engine pool
+            bool        nativeEngine;
+
+            // Moves of concurrent games of a network computed in one
+            // forward pass, see InferenceBatcher; zero computes every move
+            // on its own. Off by default: games wait for their batch to
+            // fill, which only pays off when a batched forward pass is much
+            // cheaper than its rows one by one.
+            unsigned    inferenceBatchSize;
+
+            Settings()
+                : boardSize( 9 )
+                , level( 1 )
+                , gameCount( 50 )
+                , roundGameCount( 5 )
+                , seed( 1 )
+                , nativeEngine( false )
+                , inferenceBatchSize( 0 )
+            {}
+        };
+
+        // Races for the eliteCount fittest; zero plays every game of
+        // everyone. Returns the number of games played.
+        unsigned
+        Evaluate( const std::vector< ANN::ConstPerceptronRef > & generation, unsigned eliteCount,
+                  std::vector< double > & fitness );
+
+        // White's margin at the end of one game
+        double
+        PlayGame( ANN::ConstPerceptronIn, unsigned game );
+
+        unsigned
+        GetGameSeed( unsigned game ) const { return mSettings.seed + game; }
+
+        // Hash of everything the fitness of a network depends on besides
+        // its weights
+        uint64_t
+        GetConfiguration() const { return mConfiguration; }
+
+        // Optional, null by default
+        void
+        SetFitnessCache( FitnessCache * fitnessCache ) { mFitnessCache = fitnessCache; }
+
+        void
+        SetGameRecorder( GameRecorder * gameRecorder ) { mGameRecorder = gameRecorder; }
+
+    public:
+        GenerationEvaluator( const Settings &, FitnessScheduler &, gnugo::EnginePool &, gnugo::ReplyCache & );
+        ~GenerationEvaluator();
+
+    private:
+        double
+        PlayGame( ANN::ConstPerceptronIn, unsigned game, InferenceBatcher * );
+
+    private:
+        Settings                mSettings;
+        uint64_t                mConfiguration;
+        FitnessScheduler &      mScheduler;
+        gnugo::EnginePool &     mEnginePool;
+        gnugo::ReplyCache &     mReplyCache;
+        FitnessCache *          mFitnessCache;
+        GameRecorder *          mGameRecorder;
+    };
+
+} // namespace training
+
+#endif // __TRAINING_GENERATION_EVALUATOR_H__
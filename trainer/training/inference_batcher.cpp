@@ -0,0 +1,140 @@
+#include "ann/network.h"
+#include "cmn/trace.h"
+#include "training/inference_batcher.h"
+
+#include <algorithm>
+
+namespace training {
+
+    InferenceBatcher::InferenceBatcher( unsigned inputCount, unsigned outputCount, BatchForward forward,
+                                        unsigned maxBatchSize, std::chrono::microseconds maxDelay )
+        : mInputCount( inputCount )
+        , mOutputCount( outputCount )
+        , mForward( forward )
+        , mMaxBatchSize( std::max( maxBatchSize, 1u ) )
+        , mMaxDelay( maxDelay )
+    {
+        mOpenBatch = NewBatch();
+    }
+
+    InferenceBatcher::~InferenceBatcher()
+    {
+    }
+
+    InferenceBatcher::BatchForward InferenceBatcher::RowByRow( ANN::ConstINetworkIn network )
+    {
+        ANN::ConstINetworkRef networkRef = network;
+        return [ networkRef ] ( const std::vector< double > & inputs, unsigned rowCount,
+                                std::vector< double > & outputs )
+        {
+            unsigned inputCount     = networkRef->GetInputsCount();
+            unsigned outputCount    = networkRef->GetOutputsCount();
+
+            std::vector< double > row( inputCount );
+            for ( unsigned i = 0; i < rowCount; ++ i )
+            {
+                std::copy( inputs.begin() + i * inputCount, inputs.begin() + ( i + 1 ) * inputCount, row.begin() );
+                const std::vector< double > rowOutputs = networkRef->Compute( row );
+                std::copy( rowOutputs.begin(), rowOutputs.end(), outputs.begin() + i * outputCount );
+            }
+        };
+    }
+
+    InferenceBatcher::BatchForward InferenceBatcher::Batched( ANN::ConstINetworkIn network )
+    {
+        ANN::ConstINetworkRef networkRef = network;
+        return [ networkRef ] ( const std::vector< double > & inputs, unsigned rowCount,
+                                std::vector< double > & outputs )
+        {
+            networkRef->ComputeBatch( inputs, rowCount, outputs );
+        };
+    }
+
+    std::shared_ptr< InferenceBatcher::Batch > InferenceBatcher::NewBatch()
+    {
+        std::shared_ptr< Batch > batch( new Batch );
+        batch->inputs.resize( mMaxBatchSize * mInputCount );
+        batch->outputs.resize( mMaxBatchSize * mOutputCount );
+        batch->rowCount = 0;
+        batch->done     = false;
+        return batch;
+    }
+
+    void InferenceBatcher::Run( Batch & batch )
+    {
+        // The batch is closed, nobody else touches its inputs. A failed
+        // forward pass still completes the batch, its callers rethrow.
+        try
+        {
+            mForward( batch.inputs, batch.rowCount, batch.outputs );
+        }
+        catch ( ... )
+        {
+            batch.exception = std::current_exception();
+        }
+
+        {
+            std::lock_guard< std::mutex > lock( mMutex );
+            batch.done = true;
+        }
+        mBatchDone.notify_all();
+    }
+
+    void InferenceBatcher::Compute( const std::vector< double > & inputs, std::vector< double > & outputs )
+    {
+        unsigned rowCount = static_cast< unsigned >( inputs.size() / mInputCount );
+        CMN_ASSERT( rowCount > 0 && rowCount <= mMaxBatchSize );
+        CMN_ASSERT( inputs.size() == rowCount * mInputCount );
+
+        std::unique_lock< std::mutex > lock( mMutex );
+
+        // No room for all the rows: close the open batch and run it here
+        while ( mOpenBatch->rowCount + rowCount > mMaxBatchSize )
+        {
+            std::shared_ptr< Batch > fullBatch = mOpenBatch;
+            mOpenBatch = NewBatch();
+            lock.unlock();
+            Run( *fullBatch );
+            lock.lock();
+        }
+
+        std::shared_ptr< Batch > batch = mOpenBatch;
+        unsigned row = batch->rowCount;
+        batch->rowCount += rowCount;
+        std::copy( inputs.begin(), inputs.end(), batch->inputs.begin() + row * mInputCount );
+
+        bool run = false;
+        if ( batch->rowCount == mMaxBatchSize )
+        {
+            run = true;
+        }
+        else
+        {
+            mBatchDone.wait_for( lock, mMaxDelay, [ &batch ] { return batch->done; } );
+
+            // Nobody closed it in time
+            run = !batch->done && ( mOpenBatch == batch );
+        }
+
+        if ( run )
+        {
+            mOpenBatch = NewBatch();
+            lock.unlock();
+            Run( *batch );
+            lock.lock();
+        }
+        else
+        {
+            mBatchDone.wait( lock, [ &batch ] { return batch->done; } );
+        }
+
+        if ( batch->exception )
+        {
+            std::rethrow_exception( batch->exception );
+        }
+
+        outputs.assign( batch->outputs.begin() + row * mOutputCount,
+                        batch->outputs.begin() + ( row + rowCount ) * mOutputCount );
+    }
+
+} // namespace training
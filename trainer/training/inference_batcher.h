@@ -0,0 +1,81 @@
+#ifndef __TRAINING_INFERENCE_BATCHER_H__
+#define __TRAINING_INFERENCE_BATCHER_H__
+
+#include "ann/types_fwd.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace training {
+
+    // Gathers network inputs submitted by concurrent games into one batch
+    // and runs a single forward pass over it. A caller waits until its
+    // batch is full or has been open for the maximum delay; whichever
+    // caller closes the batch runs the forward pass for everybody in it,
+    // so no extra thread is needed.
+
+    class InferenceBatcher
+    {
+    public:
+        // Computes rowCount rows of outputs from rowCount rows of inputs,
+        // both stored row after row
+        typedef std::function< void( const std::vector< double > & inputs, unsigned rowCount,
+                                     std::vector< double > & outputs ) > BatchForward;
+
+        // Forward pass made of one INetwork::Compute() per row, for
+        // networks without a batched one
+        static BatchForward
+        RowByRow( ANN::ConstINetworkIn );
+
+        // Forward pass made of one INetwork::ComputeBatch() per batch
+        static BatchForward
+        Batched( ANN::ConstINetworkIn );
+
+        // Blocks until the outputs for the inputs are ready. The inputs can
+        // be several rows, up to the maximum batch size; they go into the
+        // same batch and come back as as many rows of outputs. Rethrows
+        // what the forward pass of the batch threw.
+        void
+        Compute( const std::vector< double > & inputs, std::vector< double > & outputs );
+
+    public:
+        InferenceBatcher( unsigned inputCount, unsigned outputCount, BatchForward,
+                          unsigned maxBatchSize, std::chrono::microseconds maxDelay );
+        ~InferenceBatcher();
+
+    private:
+        struct Batch
+        {
+            std::vector< double >   inputs;
+            std::vector< double >   outputs;
+            unsigned                rowCount;
+            bool                    done;
+            std::exception_ptr      exception;  // of the forward pass
+        };
+
+        std::shared_ptr< Batch >
+        NewBatch();
+
+        void
+        Run( Batch & );
+
+    private:
+        unsigned                    mInputCount;
+        unsigned                    mOutputCount;
+        BatchForward                mForward;
+        unsigned                    mMaxBatchSize;
+        std::chrono::microseconds   mMaxDelay;
+
+        std::mutex                  mMutex;
+        std::condition_variable     mBatchDone;
+        std::shared_ptr< Batch >    mOpenBatch;
+    };
+
+} // namespace training
+
+#endif // __TRAINING_INFERENCE_BATCHER_H__
@@ -0,0 +1,51 @@
+#include "ann/network.h"
+#include "cmn/trace.h"
+#include "go/board.h"
+#include "go/utils.h"
+#include "training/inference_batcher.h"
+#include "training/player_network.h"
+
+namespace training {
+
+    using namespace go;
+
+    PlayerNetwork::PlayerNetwork( ANN::ConstINetworkIn network, InferenceBatcher * batcher /* = nullptr */ )
+        : mNetwork( network )
+        , mBatcher( batcher )
+        , mColor( COLOR_UNKNOWN )
+    {
+    }
+
+    PlayerNetwork::~PlayerNetwork()
+    {
+    }
+
+    void PlayerNetwork::Init( Color color, unsigned boardSize )
+    {
+        mColor = color;
+
+        unsigned cellCount = boardSize * boardSize;
+        CMN_ASSERT( mNetwork->GetInputsCount() == cellCount );
+        CMN_ASSERT( mNetwork->GetOutputsCount() == ( cellCount + 1 ) );
+
+        mInputs.resize( cellCount );
+    }
+
+    Move PlayerNetwork::MakeMove( const Board & board )
+    {
+        EncodeBoard( board, mColor, mInputs );
+
+        if ( mBatcher )
+        {
+            mBatcher->Compute( mInputs, mOutputs );
+        }
+        else
+        {
+            mOutputs = mNetwork->Compute( mInputs );
+        }
+
+        board.GetLegalMoves( mColor, mLegalMoves );
+        return MoveFromIndex( FindBestMove( mOutputs, mLegalMoves ), board.GetSize() );
+    }
+
+} // namespace training
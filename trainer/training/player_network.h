@@ -0,0 +1,41 @@
+#ifndef __TRAINING_PLAYER_NETWORK_H__
+#define __TRAINING_PLAYER_NETWORK_H__
+
+#include "ann/types_fwd.h"
+#include "go/player.h"
+
+#include <vector>
+
+namespace training {
+
+    class InferenceBatcher;
+
+    // Network player for games without an engine: plays the legal move the
+    // network rates best, legality coming from the board alone. Same
+    // inputs and outputs as gnugo::PlayerAnn.
+
+    class PlayerNetwork : public go::IPlayer
+    {
+    public:
+        void
+        Init( go::Color, unsigned boardSize );
+
+        go::Move
+        MakeMove( const go::Board & );
+
+    public:
+        PlayerNetwork( ANN::ConstINetworkIn, InferenceBatcher * = nullptr );
+        ~PlayerNetwork();
+
+    private:
+        ANN::ConstINetworkRef   mNetwork;
+        InferenceBatcher *      mBatcher;
+        go::Color               mColor;
+        std::vector< double >   mInputs;
+        std::vector< double >   mOutputs;
+        std::vector< bool >     mLegalMoves;
+    };
+
+} // namespace training
+
+#endif // __TRAINING_PLAYER_NETWORK_H__
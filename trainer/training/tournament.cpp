@@ -0,0 +1,95 @@
+#include "cmn/thread_pool.h"
+#include "go/local_game.h"
+#include "go/scorer.h"
+#include "training/tournament.h"
+
+#include <cmath>
+
+namespace training {
+
+    static const double kInitialRating  = 1500.0;
+    static const double kDefaultKFactor = 16.0;
+
+    Tournament::Tournament( unsigned memberCount, unsigned boardSize, Cmn::ThreadPool & pool )
+        : mPool( pool )
+        , mBoardSize( boardSize )
+        , mKomi( 7.5f )
+        , mKFactor( kDefaultKFactor )
+        , mRatings( memberCount, kInitialRating )
+        , mGameCounts( memberCount, 0 )
+    {
+    }
+
+    Tournament::~Tournament()
+    {
+    }
+
+    void Tournament::PlayRoundRobin( const PlayerFactory & factory, unsigned gamesPerPair )
+    {
+        struct Pairing
+        {
+            unsigned    black;
+            unsigned    white;
+            unsigned    game;
+            double      blackScore;
+        };
+
+        unsigned memberCount = static_cast< unsigned >( mRatings.size() );
+
+        std::vector< Pairing > pairings;
+        for ( unsigned first = 0; first < memberCount; ++ first )
+        {
+            for ( unsigned second = first + 1; second < memberCount; ++ second )
+            {
+                for ( unsigned game = 0; game < gamesPerPair; ++ game )
+                {
+                    Pairing pairing;
+                    pairing.black       = ( game % 2 ) ? second : first;
+                    pairing.white       = ( game % 2 ) ? first : second;
+                    pairing.game        = game;
+                    pairing.blackScore  = 0.0;
+                    pairings.push_back( pairing );
+                }
+            }
+        }
+
+        // Waits for the round's games only, the pool may be busy with
+        // other work
+        Cmn::TaskGroup group( mPool );
+        for ( Pairing & pairing : pairings )
+        {
+            Pairing * p = &pairing;
+            group.Submit( [ this, &factory, p ] {
+                std::unique_ptr< go::IPlayer > black = factory( p->black, p->game );
+                std::unique_ptr< go::IPlayer > white = factory( p->white, p->game );
+
+                go::LocalGame game( mBoardSize, *black, *white );
+                game.Play();
+
+                go::Scorer scorer( mKomi, go::SCORING_MODE_FAST );
+                float score = scorer.GetScore( game.GetBoard(), go::COLOR_BLACK );
+                p->blackScore = ( score > 0.0f ) ? 1.0 : ( score < 0.0f ) ? 0.0 : 0.5;
+            } );
+        }
+
+        group.Wait();
+
+        for ( const Pairing & pairing : pairings )
+        {
+            UpdateRatings( pairing.black, pairing.white, pairing.blackScore );
+        }
+    }
+
+    void Tournament::UpdateRatings( unsigned black, unsigned white, double blackScore )
+    {
+        double expected = 1.0 / ( 1.0 + std::pow( 10.0, ( mRatings[ white ] - mRatings[ black ] ) / 400.0 ) );
+        double delta    = mKFactor * ( blackScore - expected );
+
+        mRatings[ black ] += delta;
+        mRatings[ white ] -= delta;
+
+        mGameCounts[ black ] ++;
+        mGameCounts[ white ] ++;
+    }
+
+} // namespace training
@@ -0,0 +1,66 @@
+#ifndef __TRAINING_TOURNAMENT_H__
+#define __TRAINING_TOURNAMENT_H__
+
+#include "go/player.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Cmn {
+    class ThreadPool;
+}
+
+namespace training {
+
+    // Round robin between the members of a population, played on the board
+    // alone, with Elo ratings. Games of a round run in parallel; results
+    // are applied to the ratings in pairing order afterwards, so ratings
+    // don't depend on which game finished first. PlayRoundRobin() waits
+    // for its own games only, and must not be called from a pool task.
+
+    class Tournament
+    {
+    public:
+        // Makes a new player for a member; every game gets its own players
+        typedef std::function< std::unique_ptr< go::IPlayer >( unsigned member, unsigned game ) > PlayerFactory;
+
+        // Every pair of members plays gamesPerPair games, alternating colors
+        void
+        PlayRoundRobin( const PlayerFactory &, unsigned gamesPerPair );
+
+        double
+        GetRating( unsigned member ) const { return mRatings[ member ]; }
+
+        const std::vector< double > &
+        GetRatings() const { return mRatings; }
+
+        unsigned
+        GetGameCount( unsigned member ) const { return mGameCounts[ member ]; }
+
+        void
+        SetKFactor( double k ) { mKFactor = k; }
+
+        void
+        SetKomi( float komi ) { mKomi = komi; }
+
+    public:
+        Tournament( unsigned memberCount, unsigned boardSize, Cmn::ThreadPool & );
+        ~Tournament();
+
+    private:
+        void
+        UpdateRatings( unsigned black, unsigned white, double blackScore );
+
+    private:
+        Cmn::ThreadPool &       mPool;
+        unsigned                mBoardSize;
+        float                   mKomi;
+        double                  mKFactor;
+        std::vector< double >   mRatings;
+        std::vector< unsigned > mGameCounts;
+    };
+
+} // namespace training
+
+#endif // __TRAINING_TOURNAMENT_H__